@@ -0,0 +1,105 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file layout_bench.cpp
+/// @brief TTL lookups on large values stored inline vs with the payload in cold<T>
+///
+/// Usage: layout_bench [elements] [lookups]
+
+#include <multi_index_lru/cold.hpp>
+#include <multi_index_lru/expirable_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct IdTag {};
+
+using Payload = std::array<std::uint64_t, 60>;  // 480 bytes
+
+struct InlineOrder {
+    std::uint64_t id;
+    Payload payload;
+};
+
+struct SplitOrder {
+    std::uint64_t id;
+    multi_index_lru::cold<Payload> payload;
+};
+
+struct IdKey {
+    using result_type = std::uint64_t;
+    template <typename Wrapped>
+    result_type operator()(const Wrapped& wrapped) const { return wrapped.value.id; }
+};
+
+template <typename Value>
+using Cache = multi_index_lru::ExpirableContainer<
+    Value,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>>;
+
+template <typename Value>
+double mega_lookups_per_second(std::size_t elements, const std::vector<std::uint64_t>& keys,
+                               std::uint64_t& checksum) {
+    // Values are created first, as when they arrive from a parser, so cold
+    // payloads are not interleaved with the container's nodes
+    std::vector<Value> values;
+    values.reserve(elements);
+    for (std::uint64_t i = 0; i < elements; ++i) {
+        values.push_back(Value{i, Payload{i}});
+    }
+    Cache<Value> cache(elements, std::chrono::hours(1), true);
+    for (auto& value : values) {
+        cache.emplace(std::move(value));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto key : keys) {
+        auto it = cache.template find<IdTag>(key);
+        checksum += it != cache.template end<IdTag>() ? it->id : 0;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(keys.size()) / elapsed.count() / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500'000;
+    const std::size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5'000'000;
+
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> keys(lookups);
+    for (auto& key : keys) {
+        key = rng() % elements;
+    }
+
+    std::uint64_t checksum = 0;
+    const double inline_rate = mega_lookups_per_second<InlineOrder>(elements, keys, checksum);
+    const double split_rate = mega_lookups_per_second<SplitOrder>(elements, keys, checksum);
+
+    std::cout << elements << " elements, " << lookups << " random TTL lookups\n"
+              << "payload inline (" << sizeof(InlineOrder) << " B value)  " << inline_rate << " M lookups/s\n"
+              << "payload cold   (" << sizeof(SplitOrder) << " B value)   " << split_rate << " M lookups/s\n"
+              << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file lazy_index_bench.cpp
+/// @brief Insert throughput with eager vs lazy secondary indices, and ordered
+/// lookups through a red-black tree vs a sorted array
+///
+/// Usage: lazy_index_bench [capacity] [inserts]
+
+#include <multi_index_lru/lazy_index.hpp>
+#include <multi_index_lru/sorted_array_index.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+struct IdTag {};
+struct SymbolTag {};
+struct AccountTag {};
+struct PriceTag {};
+
+struct Order {
+    std::uint64_t id;
+    std::string symbol;
+    std::uint32_t account;
+    std::int64_t price;
+};
+
+using IdKey = boost::multi_index::member<Order, std::uint64_t, &Order::id>;
+using SymbolKey = boost::multi_index::member<Order, std::string, &Order::symbol>;
+using AccountKey = boost::multi_index::member<Order, std::uint32_t, &Order::account>;
+using PriceKey = boost::multi_index::member<Order, std::int64_t, &Order::price>;
+
+using EagerCache = multi_index_lru::Container<
+    Order,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>,
+        boost::multi_index::hashed_non_unique<boost::multi_index::tag<SymbolTag>, SymbolKey>,
+        boost::multi_index::hashed_non_unique<boost::multi_index::tag<AccountTag>, AccountKey>,
+        boost::multi_index::ordered_non_unique<boost::multi_index::tag<PriceTag>, PriceKey>>>;
+
+using LazyCache = multi_index_lru::LazyIndexedContainer<
+    Order,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>,
+    multi_index_lru::lazy_indexed_by<
+        multi_index_lru::lazy_hashed_non_unique<SymbolTag, SymbolKey>,
+        multi_index_lru::lazy_hashed_non_unique<AccountTag, AccountKey>,
+        multi_index_lru::lazy_ordered_non_unique<PriceTag, PriceKey>>>;
+
+template <typename PriceSpec>
+using PriceCache = multi_index_lru::LazyIndexedContainer<
+    Order,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>,
+    multi_index_lru::lazy_indexed_by<PriceSpec>>;
+
+using TreePriceCache = PriceCache<multi_index_lru::lazy_ordered_non_unique<PriceTag, PriceKey>>;
+using ArrayPriceCache = PriceCache<multi_index_lru::lazy_sorted_array<PriceTag, PriceKey>>;
+
+Order make_order(std::uint64_t i) {
+    return Order{i, "SYM" + std::to_string(i % 500), static_cast<std::uint32_t>(i % 10'000),
+                 static_cast<std::int64_t>((i * 7919) % 100'000)};
+}
+
+template <typename Cache>
+double mega_inserts_per_second(std::size_t capacity, std::size_t inserts) {
+    Cache cache(capacity);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < inserts; ++i) {
+        cache.insert(make_order(i));
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(inserts) / elapsed.count() / 1e6;
+}
+
+/// Million price range scans of ~10 elements per second
+template <typename Cache>
+double mega_scans_per_second(std::size_t capacity, std::size_t scans, std::uint64_t& checksum) {
+    Cache cache(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        cache.insert(make_order(i));
+    }
+    cache.template build_index<PriceTag>();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < scans; ++i) {
+        const auto lower = static_cast<std::int64_t>((i * 104'729) % 100'000);
+        auto [first, last] = cache.template range_no_update<PriceTag>(lower, lower + 10);
+        for (auto it = first; it != last; ++it) {
+            checksum += it->id;
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(scans) / elapsed.count() / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t capacity = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const std::size_t inserts = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2'000'000;
+
+    const double eager = mega_inserts_per_second<EagerCache>(capacity, inserts);
+    const double lazy = mega_inserts_per_second<LazyCache>(capacity, inserts);
+
+    std::uint64_t checksum = 0;
+    const double tree = mega_scans_per_second<TreePriceCache>(capacity, inserts, checksum);
+    const double array = mega_scans_per_second<ArrayPriceCache>(capacity, inserts, checksum);
+
+    std::cout << "capacity " << capacity << ", " << inserts << " inserts / range scans\n"
+              << "4 eager indices            " << eager << " M inserts/s\n"
+              << "1 eager + 3 lazy (unbuilt) " << lazy << " M inserts/s\n"
+              << "price scans, ordered tree  " << tree << " M scans/s\n"
+              << "price scans, sorted array  " << array << " M scans/s\n"
+              << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file numa_bench.cpp
+/// @brief Compare first-touch placement with NUMA-bound shards and replicas
+///
+/// Usage: numa_bench [elements] [threads_per_node] [seconds]
+///
+/// Scenarios:
+///   first-touch  ShardedContainer with std::allocator filled from node 0;
+///                readers on every node
+///   numa-shards  ShardedContainer whose shards are bound round-robin to
+///                nodes; each reader looks up keys of its local shards
+///   replicated   ReplicatedContainer with one node-bound replica per node
+
+#include <multi_index_lru/numa.hpp>
+#include <multi_index_lru/replicated_container.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct KeyTag {};
+
+struct Entry {
+    std::uint64_t key;
+    std::array<char, 64> payload;
+};
+
+using Indices = boost::multi_index::indexed_by<
+    boost::multi_index::hashed_unique<
+        boost::multi_index::tag<KeyTag>,
+        boost::multi_index::member<Entry, std::uint64_t, &Entry::key>>>;
+
+using NumaEntryAllocator = multi_index_lru::NumaAllocator<Entry>;
+using PlainSharded = multi_index_lru::ShardedContainer<Entry, Indices>;
+using NumaSharded = multi_index_lru::ShardedContainer<Entry, Indices, NumaEntryAllocator>;
+using Replicated = multi_index_lru::ReplicatedContainer<Entry, Indices, NumaEntryAllocator>;
+
+/// Run threads_per_node readers on every node; lookup(node, key) per operation
+double run_readers(int nodes, int threads_per_node, double seconds,
+                   const std::vector<std::vector<std::uint64_t>>& keys_by_node,
+                   const std::function<bool(std::uint64_t)>& lookup) {
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total{0};
+    std::vector<std::thread> threads;
+
+    for (int node = 0; node < nodes; ++node) {
+        for (int t = 0; t < threads_per_node; ++t) {
+            threads.emplace_back([&, node, t] {
+                multi_index_lru::numa::run_on_node(node);
+                const auto& keys = keys_by_node[static_cast<std::size_t>(node)];
+                std::uint64_t state = 0x9e3779b97f4a7c15ULL * static_cast<std::uint64_t>(node * 64 + t + 1);
+                std::uint64_t ops = 0;
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 256; ++i) {
+                        state ^= state << 13U;
+                        state ^= state >> 7U;
+                        state ^= state << 17U;
+                        lookup(keys[state % keys.size()]);
+                    }
+                    ops += 256;
+                }
+                total.fetch_add(ops, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return static_cast<double>(total.load()) / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const int threads_per_node = argc > 2 ? std::atoi(argv[2]) : 2;
+    const double seconds = argc > 3 ? std::atof(argv[3]) : 2.0;
+
+    const int nodes = multi_index_lru::numa::node_count();
+    const std::size_t shard_count = static_cast<std::size_t>(nodes) * 8;
+
+    std::cout << "NUMA nodes: " << nodes
+              << (multi_index_lru::numa::available() ? "" : " (libnuma unavailable, no binding)") << '\n'
+              << "elements: " << elements << ", readers per node: " << threads_per_node
+              << ", shards: " << shard_count << "\n\n";
+    if (nodes == 1) {
+        std::cout << "Single node: all scenarios access local memory; differences show allocator effects only\n\n";
+    }
+
+    // Fill everything from node 0, as a single loader thread would
+    multi_index_lru::numa::run_on_node(0);
+
+    PlainSharded plain(elements, shard_count, true);
+    NumaSharded bound(elements, shard_count, [](std::size_t shard) {
+        return NumaEntryAllocator(multi_index_lru::numa::node_for_shard(shard));
+    }, true);
+    for (std::uint64_t key = 0; key < elements; ++key) {
+        plain.insert(Entry{key, {}});
+        bound.insert(Entry{key, {}});
+    }
+
+    // Readers on node n use the keys whose shard is bound to node n
+    std::vector<std::vector<std::uint64_t>> local_keys(static_cast<std::size_t>(nodes));
+    for (std::uint64_t key = 0; key < elements; ++key) {
+        const auto node = multi_index_lru::numa::node_for_shard(bound.shard_index_for_key(key));
+        local_keys[static_cast<std::size_t>(node)].push_back(key);
+    }
+
+    const auto noop = [](const Entry&) {};
+    const double first_touch = run_readers(nodes, threads_per_node, seconds, local_keys,
+        [&](std::uint64_t key) { return plain.visit_no_update<KeyTag>(key, noop); });
+    const double numa_shards = run_readers(nodes, threads_per_node, seconds, local_keys,
+        [&](std::uint64_t key) { return bound.visit_no_update<KeyTag>(key, noop); });
+
+    std::vector<std::vector<std::uint64_t>> all_keys(static_cast<std::size_t>(nodes));
+    for (auto& keys : all_keys) {
+        for (std::uint64_t key = 0; key < elements; ++key) {
+            keys.push_back(key);
+        }
+    }
+    Replicated replicated(elements, static_cast<std::size_t>(nodes), [](std::size_t replica) {
+        return NumaEntryAllocator(static_cast<int>(replica));
+    });
+    for (std::uint64_t key = 0; key < elements; ++key) {
+        replicated.insert(Entry{key, {}});
+    }
+    const double replicas = run_readers(nodes, threads_per_node, seconds, all_keys,
+        [&](std::uint64_t key) { return replicated.visit_no_update<KeyTag>(key, noop); });
+
+    std::cout << "first-touch  " << first_touch << " Mops/s\n"
+              << "numa-shards  " << numa_shards << " Mops/s\n"
+              << "replicated   " << replicas << " Mops/s\n";
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file sbe_extract_bench.cpp
+/// @brief Key extraction throughput: view-based builder, fixed offsets, batches and gathered columns
+///
+/// Usage: sbe_extract_bench [messages] [rounds]
+
+#include <multi_index_lru/sbe_fixed.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <vector>
+
+namespace {
+
+using Entry = multi_index_lru::SbeEntryWithKeys_t<std::uint16_t, std::uint32_t>;
+using TemplateId = multi_index_lru::sbe_fixed_field<std::uint16_t, 8>;
+using SecurityId = multi_index_lru::sbe_fixed_field<std::uint32_t, 10>;
+
+/// Stand-in for a generated flyweight: accessors decode from the message bytes
+struct QuoteView {
+    std::span<const std::uint8_t> bytes;
+    std::uint16_t template_id() const { return TemplateId{}(bytes); }
+    std::uint32_t security_id() const { return SecurityId{}(bytes); }
+};
+
+template <typename F>
+double mega_per_second(std::size_t messages, std::size_t rounds, F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        f();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(messages * rounds) / elapsed.count() / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const std::size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+
+    // 14-byte quotes packed back to back, as in a received packet
+    std::vector<std::uint8_t> buffer(messages * 14, 0);
+    std::vector<std::uint32_t> offsets(messages);
+    for (std::size_t i = 0; i < messages; ++i) {
+        offsets[i] = static_cast<std::uint32_t>(i * 14);
+        buffer[i * 14 + 8] = static_cast<std::uint8_t>(i);
+        buffer[i * 14 + 10] = static_cast<std::uint8_t>(i >> 3U);
+    }
+
+    auto view_builder = multi_index_lru::make_sbe_entry_builder<Entry>(
+        [](std::span<const std::uint8_t> bytes) { return QuoteView{bytes}; },
+        multi_index_lru::make_sbe_field<std::uint16_t>(&QuoteView::template_id),
+        multi_index_lru::make_sbe_field<std::uint32_t>(&QuoteView::security_id));
+    multi_index_lru::FixedSbeEntryBuilder<Entry, TemplateId, SecurityId> fixed_builder;
+
+    std::vector<Entry::keys_type> keys(messages);
+    std::uint64_t checksum = 0;
+
+    const double view = mega_per_second(messages, rounds, [&] {
+        for (std::size_t i = 0; i < messages; ++i) {
+            keys[i] = view_builder.build(std::span(buffer).subspan(offsets[i], 14)).keys;
+        }
+    });
+    checksum += std::get<1>(keys.back());
+    const double fixed = mega_per_second(messages, rounds, [&] {
+        for (std::size_t i = 0; i < messages; ++i) {
+            keys[i] = fixed_builder.extract_keys(std::span(buffer).subspan(offsets[i], 14));
+        }
+    });
+    checksum += std::get<1>(keys.back());
+    const double batch = mega_per_second(messages, rounds, [&] {
+        fixed_builder.extract_keys_batch(buffer, offsets, keys);
+    });
+    checksum += std::get<1>(keys.back());
+
+    std::vector<std::uint16_t> template_ids(messages);
+    std::vector<std::uint32_t> security_ids(messages);
+    const double columns = mega_per_second(messages, rounds, [&] {
+        fixed_builder.extract_column<0>(buffer, offsets, template_ids);
+        fixed_builder.extract_column<1>(buffer, offsets, security_ids);
+    });
+    checksum += security_ids.back();
+
+#if defined(__AVX2__)
+    const char* simd = "AVX2 gathers";
+#else
+    const char* simd = "scalar, built without AVX2";
+#endif
+    std::cout << "messages: " << messages << " x " << rounds << " rounds\n"
+              << "view builder (build)      " << view << " M msg/s\n"
+              << "fixed offsets (keys)      " << fixed << " M msg/s\n"
+              << "batch tuples              " << batch << " M msg/s\n"
+              << "columns (" << simd << ")  " << columns << " M msg/s\n"
+              << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file timestamp_storage_bench.cpp
+/// @brief Hits, cleanup and memory of ExpirableContainer's timestamp storages
+///
+/// For inline_timestamps, slot_timestamps and generation_timestamps: fills
+/// a cache, times random hits, waits for everything to expire and times
+/// the cleanup_expired() call that drops it, and reports bytes per element.
+///
+/// Usage: timestamp_storage_bench [elements] [lookups]
+
+#include <multi_index_lru/expirable_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct IdTag {};
+
+// 20 bytes: with a 4-byte generation the node drops to a smaller malloc size class
+struct Quote {
+    std::uint32_t id;
+    float bid;
+    float ask;
+    std::uint32_t volume;
+    std::uint32_t sequence;
+};
+
+struct IdKey {
+    using result_type = std::uint32_t;
+    template <typename Wrapped>
+    result_type operator()(const Wrapped& wrapped) const { return wrapped.value.id; }
+};
+
+template <typename Storage>
+using Cache = multi_index_lru::ExpirableContainer<
+    Quote,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>,
+    std::allocator<Quote>,
+    Storage>;
+
+template <typename Storage>
+void run(const std::string& name, std::size_t elements, std::size_t lookups) {
+    using clock = std::chrono::steady_clock;
+    const std::chrono::seconds ttl(1);
+    Cache<Storage> cache(elements, ttl, true);
+    for (std::uint32_t i = 0; i < elements; ++i) {
+        cache.insert(Quote{i, 1.0F, 1.1F, 100, i});
+    }
+    const double bytes_per_element =
+        static_cast<double>(cache.memory_usage().total()) / static_cast<double>(elements);
+
+    std::mt19937 rng(7);
+    std::size_t hits = 0;
+    const auto lookup_start = clock::now();
+    for (std::size_t i = 0; i < lookups; ++i) {
+        hits += cache.template contains<IdTag>(static_cast<std::uint32_t>(rng() % elements)) ? 1 : 0;
+    }
+    const auto lookup_time = clock::now() - lookup_start;
+
+    std::this_thread::sleep_for(ttl + std::chrono::milliseconds(50));
+    const auto cleanup_start = clock::now();
+    cache.cleanup_expired();
+    const auto cleanup_time = clock::now() - cleanup_start;
+
+    std::cout << name
+              << "  hit " << std::chrono::duration<double, std::nano>(lookup_time).count() / lookups << " ns"
+              << ", cleanup " << std::chrono::duration<double, std::micro>(cleanup_time).count() << " us"
+              << " (" << cache.size() << " left)"
+              << ", " << bytes_per_element << " bytes/element"
+              << (hits == lookups ? "" : "  [unexpected misses]") << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000;
+
+    std::cout << elements << " elements, " << lookups << " random hits, then cleanup of all\n";
+    run<multi_index_lru::inline_timestamps>("inline    ", elements, lookups);
+    run<multi_index_lru::slot_timestamps>("slot      ", elements, lookups);
+    run<multi_index_lru::generation_timestamps>("generation", elements, lookups);
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file ttl_jitter_bench.cpp
+/// @brief Miss burstiness after a bulk load, with and without TTL jitter
+///
+/// Bulk-loads a cache and reports how many elements are due to expire in
+/// the same millisecond. Then, for three TTLs, serves random lookups
+/// (reloading on a miss) and runs cleanup_expired() every millisecond,
+/// reporting the peak misses in any millisecond and the longest
+/// cleanup_expired() call.
+///
+/// Usage: ttl_jitter_bench [elements] [ttl_ms] [lookups_per_ms]
+
+#include <multi_index_lru/expirable_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+
+namespace {
+
+struct IdTag {};
+
+struct Quote {
+    std::uint64_t id;
+    double price;
+};
+
+struct IdKey {
+    using result_type = std::uint64_t;
+    template <typename Wrapped>
+    result_type operator()(const Wrapped& wrapped) const { return wrapped.value.id; }
+};
+
+using Cache = multi_index_lru::ExpirableContainer<
+    Quote,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>>;
+
+struct Result {
+    std::size_t misses = 0;
+    std::size_t peak_misses_per_ms = 0;
+    std::size_t peak_deadlines_per_ms = 0;
+    std::chrono::microseconds longest_cleanup{0};
+};
+
+Result run(std::size_t elements, std::chrono::milliseconds ttl, std::size_t lookups_per_ms,
+           std::chrono::milliseconds jitter, multi_index_lru::JitterMode mode) {
+    Cache cache(elements, ttl, true);
+    if (jitter.count() > 0) {
+        cache.set_ttl_jitter(jitter, mode);
+    }
+    for (std::uint64_t i = 0; i < elements; ++i) {
+        cache.emplace(Quote{i, 1.0});
+    }
+
+    Result result;
+    std::map<std::int64_t, std::size_t> deadlines;  // expiry millisecond -> elements
+    for (std::uint64_t i = 0; i < elements; ++i) {
+        const auto expiry = cache.find_no_update<IdTag>(i).base()->last_accessed + ttl;
+        ++deadlines[std::chrono::duration_cast<std::chrono::milliseconds>(expiry.time_since_epoch()).count()];
+    }
+    for (const auto& [ms, count] : deadlines) {
+        result.peak_deadlines_per_ms = std::max(result.peak_deadlines_per_ms, count);
+    }
+
+    std::mt19937_64 rng(7);
+    const auto start = std::chrono::steady_clock::now();
+    auto tick = start;
+    while (tick - start < 3 * ttl) {
+        tick += std::chrono::milliseconds(1);
+        std::size_t misses = 0;
+        for (std::size_t i = 0; i < lookups_per_ms; ++i) {
+            const auto key = rng() % elements;
+            if (cache.find<IdTag>(key) == cache.end<IdTag>()) {
+                cache.emplace(Quote{key, 1.0});  // reload from the backend
+                ++misses;
+            }
+        }
+        const auto cleanup_start = std::chrono::steady_clock::now();
+        cache.cleanup_expired();
+        const auto cleanup_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - cleanup_start);
+
+        result.misses += misses;
+        result.peak_misses_per_ms = std::max(result.peak_misses_per_ms, misses);
+        result.longest_cleanup = std::max(result.longest_cleanup, cleanup_time);
+        while (std::chrono::steady_clock::now() < tick) {
+        }
+    }
+    return result;
+}
+
+void report(const std::string& name, const Result& result) {
+    std::cout << name << "  peak expiring in one ms " << result.peak_deadlines_per_ms
+              << ", misses " << result.misses
+              << ", peak misses/ms " << result.peak_misses_per_ms
+              << ", longest cleanup " << result.longest_cleanup.count() << " us\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    const std::chrono::milliseconds ttl(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200);
+    const std::size_t lookups_per_ms = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200;
+    const auto jitter = ttl / 4;
+
+    std::cout << elements << " elements bulk-loaded, TTL " << ttl.count() << " ms, "
+              << lookups_per_ms << " random lookups/ms for " << 3 * ttl.count() << " ms\n";
+    report("no jitter          ", run(elements, ttl, lookups_per_ms, std::chrono::milliseconds(0),
+                                      multi_index_lru::JitterMode::random));
+    report("jitter TTL/4 random", run(elements, ttl, lookups_per_ms, jitter,
+                                      multi_index_lru::JitterMode::random));
+    report("jitter TTL/4 per key", run(elements, ttl, lookups_per_ms, jitter,
+                                       multi_index_lru::JitterMode::per_key));
+    return 0;
+}
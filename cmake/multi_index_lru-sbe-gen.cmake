@@ -0,0 +1,56 @@
+# multi_index_lru_generate_sbe_cache(
+#     TARGET <target>
+#     SCHEMA <schema.xml>
+#     MESSAGE <message name>
+#     KEYS <field>[:<index kind>] ...
+#     NAMESPACE <c++ namespace>
+#     OUTPUT <header path>
+#     [HEADER_TYPE <message header composite>])
+#
+# Generates a header with the entry type, index tags, index specifiers and a
+# FixedSbeEntryBuilder for one SBE message (see tools/sbe_cache_gen.py), adds
+# it to TARGET and puts its directory on TARGET's include path. The header is
+# regenerated whenever the schema or the generator changes.
+
+# Installed next to this file; in the source tree it lives in tools/
+if(EXISTS "${CMAKE_CURRENT_LIST_DIR}/sbe_cache_gen.py")
+    set(MULTI_INDEX_LRU_SBE_CACHE_GEN "${CMAKE_CURRENT_LIST_DIR}/sbe_cache_gen.py")
+else()
+    get_filename_component(MULTI_INDEX_LRU_SBE_CACHE_GEN
+        "${CMAKE_CURRENT_LIST_DIR}/../tools/sbe_cache_gen.py" ABSOLUTE)
+endif()
+
+function(multi_index_lru_generate_sbe_cache)
+    cmake_parse_arguments(ARG "" "TARGET;SCHEMA;MESSAGE;NAMESPACE;OUTPUT;HEADER_TYPE" "KEYS" ${ARGN})
+    foreach(required TARGET SCHEMA MESSAGE NAMESPACE OUTPUT KEYS)
+        if(NOT ARG_${required})
+            message(FATAL_ERROR "multi_index_lru_generate_sbe_cache: ${required} is required")
+        endif()
+    endforeach()
+    if(NOT ARG_HEADER_TYPE)
+        set(ARG_HEADER_TYPE messageHeader)
+    endif()
+
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+    get_filename_component(schema "${ARG_SCHEMA}" ABSOLUTE)
+    get_filename_component(output "${ARG_OUTPUT}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_BINARY_DIR}")
+    get_filename_component(output_dir "${output}" DIRECTORY)
+
+    add_custom_command(
+        OUTPUT "${output}"
+        COMMAND "${CMAKE_COMMAND}" -E make_directory "${output_dir}"
+        COMMAND Python3::Interpreter "${MULTI_INDEX_LRU_SBE_CACHE_GEN}"
+            --schema "${schema}"
+            --message "${ARG_MESSAGE}"
+            --keys ${ARG_KEYS}
+            --namespace "${ARG_NAMESPACE}"
+            --header-type "${ARG_HEADER_TYPE}"
+            --output "${output}"
+        DEPENDS "${schema}" "${MULTI_INDEX_LRU_SBE_CACHE_GEN}"
+        COMMENT "Generating ${ARG_MESSAGE} cache types from ${ARG_SCHEMA}"
+        VERBATIM
+    )
+    target_sources(${ARG_TARGET} PRIVATE "${output}")
+    target_include_directories(${ARG_TARGET} PRIVATE "${output_dir}")
+endfunction()
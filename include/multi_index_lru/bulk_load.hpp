@@ -0,0 +1,219 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/bulk_load.hpp
+/// @brief Parallel bulk loading of a ShardedContainer on a work-stealing pool
+
+#include <multi_index_lru/container.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+/// @brief Run tasks [0, task_count) on worker threads with work stealing
+/// @param task_count Number of tasks
+/// @param worker_count Number of workers, including the calling thread
+/// @param f Called as f(worker_index, task_index) exactly once per task
+///
+/// Every worker starts with a contiguous block of tasks and takes them from
+/// the front; a worker that runs out steals from the back of another
+/// worker's block. The first exception thrown by f stops all workers and is
+/// rethrown on the calling thread.
+template <typename F>
+void run_work_stealing(std::size_t task_count, std::size_t worker_count, F&& f) {
+    if (task_count == 0) {
+        return;
+    }
+    worker_count = std::clamp<std::size_t>(worker_count, 1, task_count);
+
+    struct alignas(kCacheLineSize) TaskRange {
+        std::mutex mutex;
+        std::size_t front = 0;
+        std::size_t back = 0;
+    };
+    std::vector<TaskRange> ranges(worker_count);
+    for (std::size_t w = 0; w < worker_count; ++w) {
+        ranges[w].front = task_count * w / worker_count;
+        ranges[w].back = task_count * (w + 1) / worker_count;
+    }
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto take_own = [&ranges](std::size_t w, std::size_t& task) {
+        std::lock_guard lock(ranges[w].mutex);
+        if (ranges[w].front == ranges[w].back) {
+            return false;
+        }
+        task = ranges[w].front++;
+        return true;
+    };
+    auto steal = [&ranges, worker_count](std::size_t w, std::size_t& task) {
+        for (std::size_t i = 1; i < worker_count; ++i) {
+            auto& victim = ranges[(w + i) % worker_count];
+            std::lock_guard lock(victim.mutex);
+            if (victim.front != victim.back) {
+                task = --victim.back;
+                return true;
+            }
+        }
+        return false;
+    };
+    auto work = [&](std::size_t w) {
+        try {
+            std::size_t task = 0;
+            while (!failed.load(std::memory_order_relaxed) && (take_own(w, task) || steal(w, task))) {
+                f(w, task);
+            }
+        } catch (...) {
+            std::lock_guard lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    for (std::size_t w = 1; w < worker_count; ++w) {
+        threads.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace detail
+
+/// @brief Options for bulk_load()
+struct BulkLoadOptions {
+    /// Worker threads including the caller; 0 uses std::thread::hardware_concurrency()
+    std::size_t threads = 0;
+    /// Inputs built per task; smaller chunks balance better, larger ones cost less
+    std::size_t chunk_size = 4096;
+};
+
+/// @brief Build values from inputs in parallel and insert them into a sharded container
+/// @param cache ShardedContainer (or anything with shard_count(), shard_index(value),
+///              with_shard(i, f) and with_fixed_shards(f))
+/// @param inputs Random-access range of inputs (e.g. spans of serialized bytes)
+/// @param build Called as build(input) on worker threads; returns the value to insert
+/// @param options Thread count and chunk size
+/// @return Number of newly inserted elements
+///
+/// Runs in two phases on a work-stealing pool. First, chunks of inputs are
+/// built concurrently and partitioned by destination shard. Then shards are
+/// filled concurrently, each by one worker under that shard's lock, with
+/// buckets reserved for the incoming elements. Within a shard, values are
+/// inserted in input order, so the result (contents, LRU order and
+/// evictions) is the same as inserting every input sequentially. The load
+/// runs inside with_fixed_shards(): a migration in progress is finished
+/// first, and reshard() waits until the load is done.
+///
+/// `build` must be safe to call concurrently; EntryBuilder and
+/// SbeEntryBuilder are, since build() is const. Exceptions from build or
+/// from insertion are rethrown after all workers stop; shards filled before
+/// the failure keep their elements.
+///
+/// Example usage:
+/// @code
+/// std::vector<std::span<const uint8_t>> messages = read_snapshot();
+/// multi_index_lru::bulk_load(cache, messages, [&builder](std::span<const uint8_t> bytes) {
+///     return builder.build<zerialize::MsgPackDeserializer>(bytes);
+/// });
+/// @endcode
+template <typename Sharded, std::ranges::random_access_range Inputs, typename Build>
+std::size_t bulk_load(Sharded& cache, const Inputs& inputs, Build&& build, BulkLoadOptions options = {}) {
+    using Value = typename Sharded::value_type;
+    static_assert(std::is_convertible_v<
+                      std::invoke_result_t<Build&, std::ranges::range_reference_t<const Inputs>>, Value>,
+                  "build(input) must return the container's value type");
+
+    if (options.chunk_size == 0) {
+        throw std::invalid_argument("Bulk load chunk size must be greater than 0");
+    }
+    const auto threads = options.threads != 0
+        ? options.threads
+        : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const auto input_count = static_cast<std::size_t>(std::ranges::size(inputs));
+    const auto chunk_count = (input_count + options.chunk_size - 1) / options.chunk_size;
+
+    // Shard indices computed in phase 1 must still be valid in phase 2
+    return cache.with_fixed_shards([&]() -> std::size_t {
+        const auto shard_count = cache.shard_count();
+
+        // Phase 1: build values, bucketed per (chunk, shard) to preserve input order
+        std::vector<std::vector<std::vector<Value>>> buckets(chunk_count);
+        detail::run_work_stealing(chunk_count, threads, [&](std::size_t, std::size_t chunk) {
+            auto& chunk_buckets = buckets[chunk];
+            chunk_buckets.resize(shard_count);
+            const auto first = chunk * options.chunk_size;
+            const auto last = std::min(first + options.chunk_size, input_count);
+            auto it = std::ranges::begin(inputs) + static_cast<std::ptrdiff_t>(first);
+            for (auto i = first; i < last; ++i, ++it) {
+                Value value = build(*it);
+                const auto shard = cache.shard_index(value);
+                chunk_buckets[shard].push_back(std::move(value));
+            }
+        });
+
+        // Phase 2: fill shards concurrently, chunks in input order
+        std::atomic<std::size_t> inserted{0};
+        detail::run_work_stealing(shard_count, threads, [&](std::size_t, std::size_t shard) {
+            std::size_t incoming = 0;
+            for (const auto& chunk_buckets : buckets) {
+                incoming += chunk_buckets[shard].size();
+            }
+            if (incoming == 0) {
+                return;
+            }
+            std::size_t shard_inserted = 0;
+            cache.with_shard(shard, [&](auto& shard_cache) {
+                shard_cache.reserve(std::min(shard_cache.capacity(), shard_cache.size() + incoming));
+                for (auto& chunk_buckets : buckets) {
+                    for (auto& value : chunk_buckets[shard]) {
+                        shard_inserted += shard_cache.insert(std::move(value)) ? 1 : 0;
+                    }
+                    std::vector<Value>().swap(chunk_buckets[shard]);
+                }
+            });
+            inserted.fetch_add(shard_inserted, std::memory_order_relaxed);
+        });
+        return inserted.load();
+    });
+}
+
+}  // namespace multi_index_lru
@@ -0,0 +1,120 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/cold.hpp
+/// @brief Out-of-line holder for rarely-read parts of cached values
+
+#include <multi_index_lru/memory_usage.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace multi_index_lru {
+
+/// @brief Value-semantic holder that stores T out of line
+///
+/// A container node holds the value followed by the index links, so a large
+/// value pushes the links (and, for ExpirableContainer, the timestamp's
+/// neighbours) onto other cache lines than the keys. Wrapping the payload
+/// that lookups do not read in cold<T> keeps the hot part of the node (keys,
+/// timestamp, links) within one or two cache lines, at the cost of one
+/// pointer dereference when the payload is read.
+///
+/// Copies copy the payload; moves transfer the pointer and leave the source
+/// empty (only assignment and destruction are valid on it afterwards).
+///
+/// @tparam T Payload type
+///
+/// Example usage:
+/// @code
+/// struct Order {
+///     std::uint64_t id;                                   // key: hot
+///     std::uint32_t account;                              // key: hot
+///     multi_index_lru::cold<OrderDetails> details;        // read after lookup only
+/// };
+///
+/// cache.emplace(Order{42, 7, multi_index_lru::cold<OrderDetails>(std::move(details))});
+/// auto it = cache.find<IdTag>(42);
+/// use(it->details->legs);
+/// @endcode
+template <typename T>
+class cold {
+public:
+    using element_type = T;
+
+    /// @brief Hold a value-initialized T
+    cold()
+        requires std::is_default_constructible_v<T>
+        : ptr_(std::make_unique<T>())
+    {}
+
+    /// @brief Hold a copy of value
+    cold(const T& value) : ptr_(std::make_unique<T>(value)) {}
+
+    /// @brief Hold value, moved
+    cold(T&& value) : ptr_(std::make_unique<T>(std::move(value))) {}
+
+    /// @brief Construct T in place from args
+    template <typename... Args>
+    explicit cold(std::in_place_t, Args&&... args)
+        : ptr_(std::make_unique<T>(std::forward<Args>(args)...))
+    {}
+
+    cold(const cold& other) : ptr_(std::make_unique<T>(*other.ptr_)) {}
+
+    cold(cold&&) noexcept = default;
+
+    cold& operator=(const cold& other) {
+        if (this != &other) {
+            ptr_ = std::make_unique<T>(*other.ptr_);
+        }
+        return *this;
+    }
+
+    cold& operator=(cold&&) noexcept = default;
+
+    ~cold() = default;
+
+    [[nodiscard]] T& get() noexcept { return *ptr_; }
+    [[nodiscard]] const T& get() const noexcept { return *ptr_; }
+
+    T& operator*() noexcept { return *ptr_; }
+    const T& operator*() const noexcept { return *ptr_; }
+
+    T* operator->() noexcept { return ptr_.get(); }
+    const T* operator->() const noexcept { return ptr_.get(); }
+
+    /// @brief Check whether a payload is held (false only after a move)
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    friend bool operator==(const cold& lhs, const cold& rhs)
+        requires requires(const T& value) { value == value; }
+    {
+        return *lhs.ptr_ == *rhs.ptr_;
+    }
+
+    /// @brief Heap bytes of the held payload, for memory_usage() accounting
+    friend std::size_t heap_bytes(const cold& holder) {
+        return holder.ptr_ ? sizeof(T) + detail::payload_bytes(*holder.ptr_) : 0;
+    }
+
+private:
+    std::unique_ptr<T> ptr_;
+};
+
+}  // namespace multi_index_lru
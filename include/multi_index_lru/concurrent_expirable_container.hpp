@@ -0,0 +1,493 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/concurrent_expirable_container.hpp
+/// @brief Sharded TTL cache whose hits only take shared locks
+
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+/// @brief Wrapper storing a coarse access timestamp that hits update atomically
+///
+/// Exposes the wrapped value as `value`, like TimestampedValue, so the same
+/// key extractors (timestamped_key, sbe_timestamped_key, ...) work with it.
+template <typename Value>
+struct AtomicTimestampedValue {
+    /// Milliseconds since the steady_clock epoch
+    using tick_type = std::int64_t;
+
+    /// Placed first, next to the value's leading fields (see TimestampedValue)
+    mutable std::atomic<tick_type> last_accessed;
+    Value value;
+
+    AtomicTimestampedValue(Value val, tick_type now)
+        : last_accessed(now), value(std::move(val)) {}
+
+    AtomicTimestampedValue(const AtomicTimestampedValue& other)
+        : last_accessed(other.last_accessed.load(std::memory_order_relaxed)), value(other.value) {}
+
+    AtomicTimestampedValue(AtomicTimestampedValue&& other) noexcept(std::is_nothrow_move_constructible_v<Value>)
+        : last_accessed(other.last_accessed.load(std::memory_order_relaxed)),
+          value(std::move(other.value)) {}
+
+    AtomicTimestampedValue& operator=(const AtomicTimestampedValue& other) {
+        value = other.value;
+        last_accessed.store(other.last_accessed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+};
+
+template <typename Value>
+    requires has_heap_bytes<Value>
+std::size_t heap_bytes(const AtomicTimestampedValue<Value>& item) {
+    return payload_bytes(item.value);
+}
+
+/// @brief Lossy buffer of hits whose LRU relocation is deferred
+///
+/// Readers append under the shard's shared lock; the buffer is drained under
+/// the exclusive lock before anything is erased, so recorded pointers are
+/// always valid when replayed. Hits beyond the capacity are dropped.
+template <typename Item, std::size_t Capacity>
+class ReadBuffer {
+public:
+    /// Record a hit; returns true when the buffer is full and should be drained
+    bool record(const Item* item) noexcept {
+        const auto slot = count_.fetch_add(1, std::memory_order_relaxed);
+        if (slot < Capacity) {
+            items_[slot].store(item, std::memory_order_relaxed);
+        }
+        return slot + 1 >= Capacity;
+    }
+
+    /// Replay recorded hits in order; caller holds the exclusive lock
+    template <typename F>
+    void drain(F&& f) {
+        const auto count = std::min<std::size_t>(count_.load(std::memory_order_relaxed), Capacity);
+        for (std::size_t i = 0; i < count; ++i) {
+            f(*items_[i].load(std::memory_order_relaxed));
+        }
+        count_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Forget recorded hits; caller holds the exclusive lock
+    void reset() noexcept { count_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::size_t> count_{0};
+    std::array<std::atomic<const Item*>, Capacity> items_{};
+};
+
+}  // namespace detail
+
+/// @brief Sharded TTL cache with lock-free timestamp checks on the read path
+///
+/// Like ExpirableContainer, but safe for concurrent use and built so hits do
+/// not serialize:
+/// - each shard is guarded by a std::shared_mutex and lookups only take it shared;
+/// - the access timestamp is a coarse atomic, checked without the exclusive lock
+///   and rewritten with a relaxed store only when it is older than
+///   touch_threshold() (so hot entries do not bounce their cache line);
+/// - moving a hit to the front of the LRU order is deferred: hits are appended
+///   to a per-shard buffer and replayed in a batch under the exclusive lock by
+///   the next writer (or when the buffer fills up).
+///
+/// Consequently expiry is accurate to touch_threshold() and LRU order is
+/// approximate. Expired entries found by a lookup are erased under the
+/// exclusive lock.
+///
+/// Routing and key extractor requirements are the same as ShardedContainer
+/// and ExpirableContainer: elements are routed by the first index, and key
+/// extractors read through the wrapper's `value` member.
+///
+/// @tparam Value The value type stored in the container
+/// @tparam IndexSpecifierList boost::multi_index::indexed_by<...> over the wrapped value
+/// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>>
+class ConcurrentExpirableContainer {
+public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using clock_type = std::chrono::steady_clock;
+    using duration_type = std::chrono::milliseconds;
+
+    /// Number of hits each shard buffers before forcing an LRU replay
+    static constexpr std::size_t kReadBufferSize = 64;
+
+    /// @brief Construct container with capacity, TTL and shard count
+    /// @param max_size Maximum number of elements across all shards
+    /// @param ttl Time-to-live for each element
+    /// @param shard_count Number of shards (must be positive)
+    /// @param reserve_buckets Size all hashed indices of every shard up front
+    ///
+    /// The touch threshold defaults to ttl / 16.
+    ConcurrentExpirableContainer(size_type max_size, duration_type ttl, size_type shard_count,
+                                 bool reserve_buckets = false)
+        : max_size_(max_size), ttl_(ttl.count()), touch_threshold_((ttl / 16).count())
+    {
+        if (max_size == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        if (ttl.count() <= 0) {
+            throw std::invalid_argument("TTL must be positive");
+        }
+        if (shard_count == 0) {
+            throw std::invalid_argument("Shard count must be greater than 0");
+        }
+        shards_.reserve(shard_count);
+        for (size_type i = 0; i < shard_count; ++i) {
+            shards_.push_back(std::make_unique<Shard>(
+                detail::shard_capacity(max_size, shard_count, i), reserve_buckets));
+        }
+    }
+
+    /// @brief Emplace a new element
+    /// @param args Arguments forwarded to value constructor
+    /// @return true if newly inserted, false if an existing element was refreshed
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        const auto now = now_ticks();
+        CacheItem item(Value{std::forward<Args>(args)...}, now);
+        auto& shard = *shards_[routing::hash_value(item) % shards_.size()];
+
+        std::unique_lock lock(shard.mutex);
+        replay_reads(shard);
+        auto& seq_index = shard.cache.get_sequenced();
+        auto result = seq_index.emplace_front(std::move(item));
+        if (!result.second) {
+            result.first->last_accessed.store(now, std::memory_order_relaxed);
+            seq_index.relocate(seq_index.begin(), result.first);
+        } else {
+            shard.cache.account_insert(*result.first);
+            if (seq_index.size() > shard.cache.capacity()) {
+                shard.cache.evict_lru();
+            }
+        }
+        return result.second;
+    }
+
+    /// @brief Insert a value (copy)
+    bool insert(const Value& value) { return emplace(value); }
+
+    /// @brief Insert a value (move)
+    bool insert(Value&& value) { return emplace(std::move(value)); }
+
+    /// @brief Find element by key, checking TTL, and return a copy
+    /// @return Copy of the element, or std::nullopt if not found or expired
+    template <typename Tag>
+    std::optional<Value> find(const auto& key) {
+        std::optional<Value> result;
+        this->template visit<Tag>(key, [&result](const Value& value) { result = value; });
+        return result;
+    }
+
+    /// @brief Find element without checking TTL or recording the access
+    /// @return Copy of the element (possibly expired), or std::nullopt if not found
+    template <typename Tag>
+    std::optional<Value> find_no_update(const auto& key) const {
+        std::optional<Value> result;
+        for_shards<Tag>(key, [&](const Shard& shard) {
+            std::shared_lock lock(shard.mutex);
+            const auto& index = shard.cache.template get_index<Tag>();
+            auto it = index.find(key);
+            if (it == index.end()) {
+                return false;
+            }
+            result = it->value;
+            return true;
+        });
+        return result;
+    }
+
+    /// @brief Run a visitor on a live element under the shared shard lock
+    /// @param key Key to search for
+    /// @param visitor Called as visitor(const Value&) if found and not expired
+    /// @return true if a live element was found
+    ///
+    /// The visitor may run concurrently with other readers of the same shard
+    /// and must not call back into the container.
+    template <typename Tag, typename Visitor>
+    bool visit(const auto& key, Visitor&& visitor) {
+        const auto now = now_ticks();
+        const auto ttl = ttl_.load(std::memory_order_relaxed);
+        const auto threshold = touch_threshold_.load(std::memory_order_relaxed);
+
+        return for_shards<Tag>(key, [&](Shard& shard) {
+            bool expired = false;
+            bool buffer_full = false;
+            {
+                std::shared_lock lock(shard.mutex);
+                const auto& index = shard.cache.template get_index<Tag>();
+                auto it = index.find(key);
+                if (it == index.end()) {
+                    return false;
+                }
+                const auto stamp = it->last_accessed.load(std::memory_order_relaxed);
+                if (now - stamp > ttl) {
+                    expired = true;
+                } else {
+                    if (now - stamp > threshold) {
+                        it->last_accessed.store(now, std::memory_order_relaxed);
+                    }
+                    buffer_full = shard.reads.record(&*it);
+                    visitor(it->value);
+                }
+            }
+            if (expired) {
+                erase_expired<Tag>(shard, key);
+                return false;
+            }
+            if (buffer_full) {
+                std::unique_lock lock(shard.mutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    replay_reads(shard);
+                }
+            }
+            return true;
+        });
+    }
+
+    /// @brief Check if a live element exists (records the access)
+    template <typename Tag>
+    bool contains(const auto& key) {
+        return this->template visit<Tag>(key, [](const Value&) {});
+    }
+
+    /// @brief Check if element exists without checking TTL or recording the access
+    template <typename Tag>
+    bool contains_no_update(const auto& key) const {
+        return this->template find_no_update<Tag>(key).has_value();
+    }
+
+    /// @brief Erase element(s) by key
+    /// @return true if at least one element was erased
+    template <typename Tag>
+    bool erase(const auto& key) {
+        bool erased = false;
+        for_shards<Tag>(key, [&](Shard& shard) {
+            std::unique_lock lock(shard.mutex);
+            replay_reads(shard);
+            erased = shard.cache.template erase<Tag>(key) || erased;
+            return false;
+        });
+        return erased;
+    }
+
+    /// @brief Remove expired elements from the back of every shard's LRU order
+    void cleanup_expired() {
+        const auto now = now_ticks();
+        const auto ttl = ttl_.load(std::memory_order_relaxed);
+        for (auto& shard : shards_) {
+            std::unique_lock lock(shard->mutex);
+            replay_reads(*shard);
+            auto& seq_index = shard->cache.get_sequenced();
+            while (!seq_index.empty() &&
+                   now - seq_index.back().last_accessed.load(std::memory_order_relaxed) > ttl) {
+                shard->cache.evict_lru();
+            }
+        }
+    }
+
+    /// @brief Apply all buffered LRU relocations now
+    void flush_reads() {
+        for (auto& shard : shards_) {
+            std::unique_lock lock(shard->mutex);
+            replay_reads(*shard);
+        }
+    }
+
+    /// @brief Get current number of elements (including expired)
+    [[nodiscard]] size_type size() const {
+        size_type total = 0;
+        for (const auto& shard : shards_) {
+            std::shared_lock lock(shard->mutex);
+            total += shard->cache.size();
+        }
+        return total;
+    }
+
+    /// @brief Check if container is empty
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// @brief Get the bytes used by all shards (see Container::memory_usage())
+    ///
+    /// Shards are locked one at a time, so under concurrent modification
+    /// the result is only a snapshot.
+    [[nodiscard]] MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        for (const auto& shard : shards_) {
+            std::shared_lock lock(shard->mutex);
+            usage += shard->cache.memory_usage();
+        }
+        return usage;
+    }
+
+    /// @brief Get current total capacity
+    [[nodiscard]] size_type capacity() const noexcept {
+        return max_size_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get number of shards
+    [[nodiscard]] size_type shard_count() const noexcept { return shards_.size(); }
+
+    /// @brief Set new total capacity (evicts LRU elements of each shard if needed)
+    void set_capacity(size_type new_capacity) {
+        if (new_capacity == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        for (size_type i = 0; i < shards_.size(); ++i) {
+            auto& shard = *shards_[i];
+            std::unique_lock lock(shard.mutex);
+            replay_reads(shard);
+            shard.cache.set_capacity(detail::shard_capacity(new_capacity, shards_.size(), i));
+        }
+        max_size_.store(new_capacity, std::memory_order_relaxed);
+    }
+
+    /// @brief Remove all elements
+    void clear() {
+        for (auto& shard : shards_) {
+            std::unique_lock lock(shard->mutex);
+            shard->reads.reset();
+            shard->cache.clear();
+        }
+    }
+
+    /// @brief Get current TTL setting
+    [[nodiscard]] duration_type ttl() const noexcept {
+        return duration_type(ttl_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Set new TTL (affects future checks)
+    void set_ttl(duration_type new_ttl) {
+        if (new_ttl.count() <= 0) {
+            throw std::invalid_argument("TTL must be positive");
+        }
+        ttl_.store(new_ttl.count(), std::memory_order_relaxed);
+    }
+
+    /// @brief Get the minimum age before a hit rewrites the access timestamp
+    [[nodiscard]] duration_type touch_threshold() const noexcept {
+        return duration_type(touch_threshold_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Set the minimum age before a hit rewrites the access timestamp
+    ///
+    /// Larger values mean fewer stores on hot entries but coarser expiry;
+    /// zero rewrites the timestamp on every hit that sees a different tick.
+    void set_touch_threshold(duration_type threshold) {
+        if (threshold.count() < 0) {
+            throw std::invalid_argument("Touch threshold must not be negative");
+        }
+        touch_threshold_.store(threshold.count(), std::memory_order_relaxed);
+    }
+
+private:
+    using CacheItem = detail::AtomicTimestampedValue<Value>;
+    using tick_type = typename CacheItem::tick_type;
+    using CacheContainer = Container<CacheItem, IndexSpecifierList,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<CacheItem>>;
+    using routing = detail::shard_routing<CacheContainer>;
+
+    struct alignas(detail::kCacheLineSize) Shard {
+        Shard(size_type capacity, bool reserve_buckets) : cache(capacity, reserve_buckets) {}
+
+        mutable std::shared_mutex mutex;
+        CacheContainer cache;
+        detail::ReadBuffer<CacheItem, kReadBufferSize> reads;
+    };
+
+    static tick_type now_ticks() {
+        return std::chrono::duration_cast<duration_type>(clock_type::now().time_since_epoch()).count();
+    }
+
+    /// Move buffered hits to the LRU front; caller holds the exclusive lock
+    static void replay_reads(Shard& shard) {
+        auto& seq_index = shard.cache.get_sequenced();
+        shard.reads.drain([&seq_index](const CacheItem& item) {
+            seq_index.relocate(seq_index.begin(), seq_index.iterator_to(item));
+        });
+    }
+
+    template <typename Tag>
+    void erase_expired(Shard& shard, const auto& key) {
+        const auto now = now_ticks();
+        const auto ttl = ttl_.load(std::memory_order_relaxed);
+        std::unique_lock lock(shard.mutex);
+        replay_reads(shard);
+        auto& index = shard.cache.template get_index<Tag>();
+        auto it = index.find(key);
+        if (it != index.end() && now - it->last_accessed.load(std::memory_order_relaxed) > ttl) {
+            shard.cache.erase(it);
+        }
+    }
+
+    /// Run finder on the routed shard, or on every shard until it returns true
+    template <typename Tag, typename Finder>
+    bool for_shards(const auto& key, Finder&& finder) {
+        if constexpr (routing::template is_routed_tag<Tag>) {
+            return finder(*shards_[routing::hash_key(key) % shards_.size()]);
+        } else {
+            for (auto& shard : shards_) {
+                if (finder(*shard)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    template <typename Tag, typename Finder>
+    bool for_shards(const auto& key, Finder&& finder) const {
+        if constexpr (routing::template is_routed_tag<Tag>) {
+            return finder(static_cast<const Shard&>(*shards_[routing::hash_key(key) % shards_.size()]));
+        } else {
+            for (const auto& shard : shards_) {
+                if (finder(static_cast<const Shard&>(*shard))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<size_type> max_size_;
+    std::atomic<tick_type> ttl_;
+    std::atomic<tick_type> touch_threshold_;
+};
+
+}  // namespace multi_index_lru
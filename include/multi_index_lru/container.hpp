@@ -18,6 +18,9 @@
 /// @file multi_index_lru/container.hpp
 /// @brief LRU container based on boost::multi_index
 
+#include <multi_index_lru/memory_usage.hpp>
+
+#include <boost/mpl/size.hpp>
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
@@ -26,6 +29,8 @@
 #include <cassert>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
@@ -33,12 +38,34 @@
 
 namespace multi_index_lru {
 
-// Forward declaration
-template <typename Value, typename IndexSpecifierList, typename Allocator>
+// Forward declarations
+template <typename Value, typename IndexSpecifierList, typename Allocator, typename TimestampStorage>
 class ExpirableContainer;
 
+template <typename Value, typename IndexSpecifierList, typename Allocator>
+class ShardedContainer;
+
+template <typename Value, typename IndexSpecifierList, typename Allocator>
+class ConcurrentExpirableContainer;
+
+template <typename Value, typename IndexSpecifierList, typename LazyIndexList, typename Allocator>
+class LazyIndexedContainer;
+
 namespace detail {
 
+/// Assumed cache line size used to keep shared state from false sharing
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/// Finalizer from splitmix64; spreads weak hashes (e.g. identity for ints)
+inline std::uint64_t mix_hash(std::uint64_t h) noexcept {
+    h ^= h >> 30U;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27U;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31U;
+    return h;
+}
+
 /// Check if type is boost::mpl::na (placeholder type)
 template <typename T, typename = void>
 inline constexpr bool is_mpl_na = false;
@@ -85,34 +112,101 @@ struct add_seq_index<boost::multi_index::indexed_by<Indices...>> {
 template <typename IndexList>
 using add_seq_index_t = typename add_seq_index<IndexList>::type;
 
-/// Wrapper that adds timestamp to stored values for TTL tracking
-template <typename Value>
-struct TimestampedValue {
+/// Detect hashed indices (the only ones with buckets to size)
+template <typename Index>
+inline constexpr bool is_hashed_index = requires(Index& index) {
+    index.bucket_count();
+    index.max_load_factor(1.0f);
+};
+
+/// Node, header, bucket and allocator slack bytes of a boost::multi_index_container
+template <typename BoostContainer>
+MemoryUsage structure_usage(const BoostContainer& container) noexcept {
+    using node_type = typename BoostContainer::final_node_type;
+    using value_type = typename BoostContainer::value_type;
+    constexpr std::size_t kIndexCount = boost::mpl::size<typename BoostContainer::index_type_list>::value;
+
+    const auto count = container.size();
+    MemoryUsage usage;
+    usage.node_values = count * sizeof(value_type);
+    usage.index_links = count * (sizeof(node_type) - sizeof(value_type)) + sizeof(node_type);
+    usage.allocator_slack = (count + 1) * malloc_slack(sizeof(node_type));
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ([&](const auto& index) {
+            if constexpr (is_hashed_index<std::remove_cvref_t<decltype(index)>>) {
+                const auto bytes = (index.bucket_count() + 1) * sizeof(void*);
+                usage.buckets += bytes;
+                usage.allocator_slack += malloc_slack(bytes);
+            }
+        }(container.template get<Is>()), ...);
+    }(std::make_index_sequence<kIndexCount>{});
+    return usage;
+}
+
+/// Metadata of TimestampedValue: the time of the element's last access
+struct LastAccessed {
+    mutable std::chrono::steady_clock::time_point last_accessed = std::chrono::steady_clock::now();
+};
+
+/// Metadata of SlottedValue: the index of the element's timestamp in a side array
+///
+/// Used by ExpirableContainer with slot_timestamps: the slot is written once
+/// on insertion, so hits do not store a timestamp into the node.
+struct TimestampSlot {
+    mutable std::uint32_t slot = 0;
+};
+
+/// Metadata of GenerationValue: the generation (TTL/8 interval) of the
+/// element's last access, used by ExpirableContainer with generation_timestamps
+struct AccessGeneration {
+    mutable std::uint32_t generation = 0;
+};
+
+/// Wrapper that adds per-element metadata to stored values for TTL tracking
+///
+/// The metadata comes first (as a base) so that the TTL check reads the
+/// same cache line as the leading fields of the value (typically its keys),
+/// however large the value is.
+template <typename Value, typename Metadata>
+struct AnnotatedValue : Metadata {
     Value value;
-    mutable std::chrono::steady_clock::time_point last_accessed;
-    
-    TimestampedValue() = default;
-    
-    explicit TimestampedValue(const Value& val) 
-        : value(val), last_accessed(std::chrono::steady_clock::now()) {}
-        
-    explicit TimestampedValue(Value&& val) 
-        : value(std::move(val)), last_accessed(std::chrono::steady_clock::now()) {}
-    
+
+    AnnotatedValue() = default;
+
+    explicit AnnotatedValue(const Value& val) : value(val) {}
+
+    explicit AnnotatedValue(Value&& val) : value(std::move(val)) {}
+
     // Implicit conversions for transparent access
     operator Value&() { return value; }
     operator const Value&() const { return value; }
-    
+
     Value* operator->() { return &value; }
     const Value* operator->() const { return &value; }
 
     Value& operator*() { return value; }
     const Value& operator*() const { return value; }
-    
+
     Value& get() { return value; }
     const Value& get() const { return value; }
 };
 
+template <typename Value, typename Metadata>
+    requires has_heap_bytes<Value>
+std::size_t heap_bytes(const AnnotatedValue<Value, Metadata>& item) {
+    return payload_bytes(item.value);
+}
+
+/// Value with its last access time, stamped on construction
+template <typename Value>
+using TimestampedValue = AnnotatedValue<Value, LastAccessed>;
+
+template <typename Value>
+using SlottedValue = AnnotatedValue<Value, TimestampSlot>;
+
+template <typename Value>
+using GenerationValue = AnnotatedValue<Value, AccessGeneration>;
+
 /// Iterator wrapper that transparently unwraps TimestampedValue
 template <typename Iterator>
 class TimestampedIteratorWrapper {
@@ -186,14 +280,48 @@ public:
     using allocator_type = Allocator;
     using size_type = std::size_t;
 
+private:
+    using ExtendedIndexSpecifierList = detail::add_seq_index_t<IndexSpecifierList>;
+
+    using BoostContainer = boost::multi_index::multi_index_container<
+        Value,
+        ExtendedIndexSpecifierList,
+        Allocator>;
+
+public:
+    /// Node handle owning an extracted element (see extract())
+    using node_type = typename BoostContainer::node_type;
+
     /// @brief Construct container with specified capacity
     /// @param max_size Maximum number of elements before LRU eviction
-    explicit Container(size_type max_size)
-        : max_size_(max_size)
+    /// @param reserve_buckets Size all hashed indices for max_size up front
+    ///
+    /// With reserve_buckets, the hashed indices never rehash while the cache
+    /// fills, and set_capacity() keeps the buckets sized for the new capacity.
+    explicit Container(size_type max_size, bool reserve_buckets = false)
+        : max_size_(max_size), reserve_buckets_(reserve_buckets)
     {
         if (max_size_ == 0) {
             throw std::invalid_argument("Container capacity must be greater than 0");
         }
+        if (reserve_buckets_) {
+            reserve(max_size_);
+        }
+    }
+
+    /// @brief Construct container with specified capacity and allocator
+    /// @param max_size Maximum number of elements before LRU eviction
+    /// @param allocator Allocator for nodes and bucket arrays (rebound internally)
+    /// @param reserve_buckets Size all hashed indices for max_size up front
+    Container(size_type max_size, const Allocator& allocator, bool reserve_buckets = false)
+        : container_(allocator), max_size_(max_size), reserve_buckets_(reserve_buckets)
+    {
+        if (max_size_ == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        if (reserve_buckets_) {
+            reserve(max_size_);
+        }
     }
 
     /// @brief Emplace a new element
@@ -209,10 +337,13 @@ public:
 
         if (!result.second) {
             seq_index.relocate(seq_index.begin(), result.first);
-        } else if (seq_index.size() > max_size_) {
-            seq_index.pop_back();
+            return false;
         }
-        return result.second;
+        account_insert(*result.first);
+        if (seq_index.size() > max_size_) {
+            evict_lru();
+        }
+        return true;
     }
 
     /// @brief Insert a value (copy)
@@ -225,6 +356,31 @@ public:
     /// @return true if newly inserted, false if existing element was refreshed
     bool insert(Value&& value) { return emplace(std::move(value)); }
 
+    /// @brief Insert an extracted element without copying it or allocating
+    /// @param node Node handle from extract() of a container of the same type
+    /// @return true if inserted at the front, false if node was empty or an
+    ///         element with matching key(s) exists
+    ///
+    /// On success node becomes empty. If a matching element exists, it is
+    /// refreshed and node keeps the element. May evict the LRU element.
+    bool insert(node_type&& node) {
+        if (node.empty()) {
+            return false;
+        }
+        auto& seq_index = container_.template get<0>();
+        auto result = seq_index.insert(seq_index.begin(), std::move(node));
+        if (!result.inserted) {
+            seq_index.relocate(seq_index.begin(), result.position);
+            node = std::move(result.node);
+            return false;
+        }
+        account_insert(*result.position);
+        if (seq_index.size() > max_size_) {
+            evict_lru();
+        }
+        return true;
+    }
+
     /// @brief Find element by key using specified index
     /// @tparam Tag Index tag type
     /// @tparam Key Key type (can often be deduced)
@@ -323,6 +479,58 @@ public:
         return this->template find_no_update<Tag, Key>(key) != this->template end<Tag>();
     }
 
+    /// @brief Modify element in place and move it to front
+    /// @tparam Tag Index tag type
+    /// @param key Key of element to modify
+    /// @param modifier Called as modifier(Value&)
+    /// @return true if the element was modified and is still in the container,
+    ///         false if not found or erased by the modification
+    ///
+    /// Uses boost::multi_index modify(): when the modifier leaves all key
+    /// fields unchanged, every index verifies the element in place in
+    /// constant time, without erasing and reinserting. If a key changes, the
+    /// element is repositioned in that index; if the new key collides with
+    /// another element on a unique index, the modified element is erased.
+    /// If the modifier throws, the element is erased and the exception
+    /// propagates.
+    template <typename Tag, typename Modifier>
+    bool modify(const auto& key, Modifier&& modifier) {
+        auto& index = container_.template get<Tag>();
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return false;
+        }
+        return modify(it, std::forward<Modifier>(modifier));
+    }
+
+    /// @brief Modify the element an iterator of any index points to and move it to front
+    /// @param it Dereferenceable iterator of one of this container's indices
+    /// @param modifier Called as modifier(Value&)
+    /// @return true if the element is still in the container, false if the
+    ///         modification erased it (see modify(key, modifier))
+    template <typename Iterator, typename Modifier>
+        requires requires(const Iterator& it) { it.get_node(); }
+    bool modify(Iterator it, Modifier&& modifier) {
+        auto& seq_index = container_.template get<0>();
+        const auto seq_it = container_.template project<0>(it);
+        const auto payload_before = detail::payload_bytes(*seq_it);
+        bool kept;
+        try {
+            kept = seq_index.modify(seq_it, std::forward<Modifier>(modifier));
+        } catch (...) {
+            // boost::multi_index erases the element when the modifier throws
+            payload_bytes_ -= payload_before;
+            throw;
+        }
+        if (!kept) {
+            payload_bytes_ -= payload_before;
+            return false;
+        }
+        payload_bytes_ = payload_bytes_ - payload_before + detail::payload_bytes(*seq_it);
+        seq_index.relocate(seq_index.begin(), seq_it);
+        return true;
+    }
+
     /// @brief Erase element by key
     /// @tparam Tag Index tag type
     /// @tparam Key Key type (can often be deduced)
@@ -330,7 +538,70 @@ public:
     /// @return true if element was erased, false if not found
     template <typename Tag, typename Key = void>
     bool erase(const auto& key) {
-        return container_.template get<Tag>().erase(key) > 0;
+        auto& index = container_.template get<Tag>();
+        if constexpr (detail::has_heap_bytes<Value>) {
+            auto [first, last] = index.equal_range(key);
+            for (auto it = first; it != last; ++it) {
+                account_erase(*it);
+            }
+            const bool erased = first != last;
+            index.erase(first, last);
+            return erased;
+        } else {
+            return index.erase(key) > 0;
+        }
+    }
+
+    /// @brief Erase the element an iterator of any index points to
+    /// @param it Dereferenceable iterator of one of this container's indices
+    /// @return Iterator following it in the same index
+    template <typename Iterator>
+        requires requires(const Iterator& it) { it.get_node(); }
+    Iterator erase(Iterator it) {
+        auto next = std::next(it);
+        account_erase(*it);
+        container_.template get<0>().erase(container_.template project<0>(it));
+        return next;
+    }
+
+    /// @brief Evict the least recently used element
+    /// @return true if an element was evicted, false if the container is empty
+    bool evict_lru() {
+        auto& seq_index = container_.template get<0>();
+        if (seq_index.empty()) {
+            return false;
+        }
+        account_erase(seq_index.back());
+        seq_index.pop_back();
+        return true;
+    }
+
+    /// @brief Remove an element and return it in a node handle
+    /// @tparam Tag Index tag type
+    /// @param key Key of element to extract
+    /// @return Node handle owning the element, or an empty handle if not found
+    ///
+    /// The element is neither copied nor deallocated; pass the handle to
+    /// insert(node_type&&) of another container of the same type (and an
+    /// equal allocator) to move it there, e.g. from a probation cache to a
+    /// long-lived one.
+    template <typename Tag>
+    node_type extract(const auto& key) {
+        auto& index = container_.template get<Tag>();
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return node_type();
+        }
+        account_erase(*it);
+        return index.extract(it);
+    }
+
+    /// @brief Remove the element an iterator of any index points to and return it
+    template <typename Iterator>
+        requires requires(const Iterator& it) { it.get_node(); }
+    node_type extract(Iterator it) {
+        account_erase(*it);
+        return container_.template get<0>().extract(container_.template project<0>(it));
     }
 
     /// @brief Get current number of elements
@@ -346,19 +617,75 @@ public:
     /// @param new_capacity New maximum size
     ///
     /// If new capacity is smaller than current size, LRU elements are evicted.
+    /// If the container was constructed with reserve_buckets, growing the
+    /// capacity rehashes the hashed indices here rather than on a later insert.
     void set_capacity(size_type new_capacity) {
         if (new_capacity == 0) {
             throw std::invalid_argument("Container capacity must be greater than 0");
         }
+        if (reserve_buckets_ && new_capacity > max_size_) {
+            reserve(new_capacity);
+        }
         max_size_ = new_capacity;
-        auto& seq_index = container_.template get<0>();
         while (container_.size() > max_size_) {
-            seq_index.pop_back();
+            evict_lru();
         }
     }
 
     /// @brief Remove all elements
-    void clear() noexcept { container_.clear(); }
+    void clear() noexcept {
+        container_.clear();
+        payload_bytes_ = 0;
+    }
+
+    /// @brief Get the bytes used by the container, by category
+    ///
+    /// Constant time: node and bucket bytes follow from size() and the bucket
+    /// counts, and payload bytes are kept up to date as elements come and go.
+    /// Payload is measured only for values with heap_bytes() (see
+    /// memory_usage.hpp), whose heap use may only change through modify().
+    /// Elements inserted or erased directly through get_container() are not
+    /// accounted for.
+    [[nodiscard]] MemoryUsage memory_usage() const noexcept {
+        auto usage = detail::structure_usage(container_);
+        usage.payload = payload_bytes_;
+        return usage;
+    }
+
+    /// @brief Size every hashed index to hold n elements without rehashing
+    /// @param n Number of elements to reserve buckets for
+    ///
+    /// Non-hashed indices are left untouched.
+    void reserve(size_type n) {
+        for_each_index([n](auto& index) {
+            if constexpr (detail::is_hashed_index<std::remove_reference_t<decltype(index)>>) {
+                index.reserve(n);
+            }
+        });
+    }
+
+    /// @brief Get the max load factor applied to hashed indices
+    [[nodiscard]] float max_load_factor() const noexcept { return max_load_factor_; }
+
+    /// @brief Set the max load factor of every hashed index
+    /// @param z New max load factor (must be positive)
+    ///
+    /// Lowering the load factor may rehash immediately; if the container was
+    /// constructed with reserve_buckets, buckets are re-reserved for capacity().
+    void max_load_factor(float z) {
+        if (!(z > 0.0f)) {
+            throw std::invalid_argument("Max load factor must be positive");
+        }
+        max_load_factor_ = z;
+        for_each_index([z](auto& index) {
+            if constexpr (detail::is_hashed_index<std::remove_reference_t<decltype(index)>>) {
+                index.max_load_factor(z);
+            }
+        });
+        if (reserve_buckets_) {
+            reserve(max_size_);
+        }
+    }
 
     /// @brief Get end iterator for specified index
     /// @tparam Tag Index tag type
@@ -401,6 +728,9 @@ public:
     /// @brief Access underlying boost::multi_index_container (const)
     [[nodiscard]] const auto& get_container() const noexcept { return container_; }
 
+    /// @brief Get a copy of the allocator
+    [[nodiscard]] allocator_type get_allocator() const { return container_.get_allocator(); }
+
     /// @brief Get a specific index by tag
     /// @tparam Tag Index tag type
     template <typename Tag>
@@ -417,19 +747,41 @@ public:
     [[nodiscard]] const auto& get_sequenced() const { return container_.template get<0>(); }
 
 private:
-    using ExtendedIndexSpecifierList = detail::add_seq_index_t<IndexSpecifierList>;
+    static constexpr std::size_t kIndexCount =
+        boost::mpl::size<typename BoostContainer::index_type_list>::value;
 
-    using BoostContainer = boost::multi_index::multi_index_container<
-        Value,
-        ExtendedIndexSpecifierList,
-        Allocator>;
+    template <typename F>
+    void for_each_index(F&& f) {
+        for_each_index_impl(f, std::make_index_sequence<kIndexCount>{});
+    }
+
+    template <typename F, std::size_t... Is>
+    void for_each_index_impl(F& f, std::index_sequence<Is...>) {
+        (f(container_.template get<Is>()), ...);
+    }
+
+    /// Payload bookkeeping: called after an element is linked and before it is unlinked
+    void account_insert(const Value& value) { payload_bytes_ += detail::payload_bytes(value); }
+    void account_erase(const Value& value) { payload_bytes_ -= detail::payload_bytes(value); }
 
     BoostContainer container_;
     size_type max_size_;
+    bool reserve_buckets_ = false;
+    float max_load_factor_ = 1.0f;
+    std::size_t payload_bytes_ = 0;
 
-    // Allow ExpirableContainer to access internals
-    template <typename V, typename I, typename A>
+    // Allow the library's wrappers to access internals
+    template <typename V, typename I, typename A, typename T>
     friend class ExpirableContainer;
+
+    template <typename V, typename I, typename A>
+    friend class ShardedContainer;
+
+    template <typename V, typename I, typename A>
+    friend class ConcurrentExpirableContainer;
+
+    template <typename V, typename I, typename L, typename A>
+    friend class LazyIndexedContainer;
 };
 
 }  // namespace multi_index_lru
@@ -20,21 +20,370 @@
 
 #include "container.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace multi_index_lru {
 
+/// @brief How long ExpirableContainer keeps serving elements past their TTL
+///
+/// Both windows start when the TTL runs out. Expired elements are kept
+/// (but not returned by find()) until the longer window ends.
+struct StalePolicy {
+    /// find_allow_stale() returns the element, flagged stale, for the caller to refresh
+    std::chrono::milliseconds stale_while_revalidate{0};
+    /// get_or_load() falls back to the element when the loader fails
+    std::chrono::milliseconds stale_if_error{0};
+};
+
+/// @brief What restarts an ExpirableContainer element's TTL
+enum class ExpirationPolicy {
+    after_access,  ///< Every hit (find(), equal_range(), ...) and every write
+    after_write    ///< Only inserting or replacing the value (and modify()); hits never write the timestamp
+};
+
+/// @brief How ExpirableContainer::set_ttl_jitter() picks each element's offset
+enum class JitterMode {
+    random,  ///< A new random offset at every timestamp write
+    per_key  ///< A fixed offset derived from the key on the first index
+};
+
+/// @brief Freshness of an element found by find_allow_stale() or get_or_load()
+enum class Freshness {
+    missing,  ///< Not found, or expired past the stale windows
+    fresh,    ///< Within its TTL
+    stale     ///< Expired, but served within a stale window
+};
+
+/// @brief Result of find_allow_stale() and get_or_load()
+template <typename Iterator>
+struct StaleLookup {
+    /// Element found, or end() if missing
+    Iterator iterator;
+    Freshness freshness;
+
+    /// @brief Check whether an element was returned, fresh or stale
+    [[nodiscard]] bool found() const noexcept { return freshness != Freshness::missing; }
+
+    /// @brief Check whether the element was served past its TTL
+    [[nodiscard]] bool stale() const noexcept { return freshness == Freshness::stale; }
+};
+
+/// @brief Keep each element's timestamp in its node, next to the value (the default)
+struct inline_timestamps {};
+
+/// @brief Keep timestamps in a dense array, indexed by a slot number stored in each node
+///
+/// Hits write the array instead of the node, and TTL checks read the array
+/// instead of the node. An element hit again within TTL/8 of its previous
+/// access keeps its LRU position, so hits on hot elements leave the node's
+/// cache lines (including its index links) clean and shareable by cores
+/// reading the same value; it moves to the front at most once per TTL/8.
+/// LRU order is therefore approximate within TTL/8 (ExpirationPolicy::
+/// after_access only; under after_write every hit moves the element). Costs
+/// a 4-byte slot per node (padded to the value's alignment) plus the 8-byte
+/// array entry.
+struct slot_timestamps {};
+
+/// @brief Keep a generation number (one per TTL/8) in each node instead of a timestamp
+///
+/// Elements accessed in the same generation share one expiry, so an element
+/// expires between 7/8 of the TTL and the TTL after its last access, never
+/// later. A ring of per-generation counts tells cleanup_expired() how many
+/// elements to drop from the LRU tail without reading their timestamps. A
+/// hit on an element already in the current generation writes neither its
+/// generation nor its index links: the element keeps its LRU position, so
+/// LRU order is only kept between generations (eviction within the newest
+/// one is approximate). Costs a 4-byte generation per node (padded to the
+/// value's alignment). Requires
+/// ExpirationPolicy::after_access and no TTL jitter, which keep the LRU order
+/// sorted by generation.
+struct generation_timestamps {};
+
+namespace detail {
+
+template <typename Storage, typename Value>
+class TimestampStore;
+
+/// Timestamps in TimestampedValue nodes
+template <typename Value>
+class TimestampStore<inline_timestamps, Value> {
+public:
+    using item_type = TimestampedValue<Value>;
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    time_point get(const item_type& item) const noexcept { return item.last_accessed; }
+    void set(const item_type& item, time_point stamp) noexcept { item.last_accessed = stamp; }
+    void attach(const item_type& item, time_point stamp) noexcept { item.last_accessed = stamp; }
+    bool recent(const item_type&, time_point, duration) const noexcept { return false; }
+    void detach(const item_type&) noexcept {}
+    void adopt(const item_type&, item_type&) noexcept {}
+    void clear() noexcept {}
+    std::size_t bytes() const noexcept { return 0; }
+};
+
+/// Timestamps in an array indexed by SlottedValue::slot, with a free list
+template <typename Value>
+class TimestampStore<slot_timestamps, Value> {
+public:
+    using item_type = SlottedValue<Value>;
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    static constexpr duration::rep kPromotionsPerTtl = 8;
+
+    time_point get(const item_type& item) const noexcept { return stamps_[item.slot]; }
+    void set(const item_type& item, time_point stamp) noexcept { stamps_[item.slot] = stamp; }
+
+    /// Whether the element was accessed within TTL/8, and so keeps its LRU position on a hit
+    bool recent(const item_type& item, time_point now, duration ttl) const noexcept {
+        return now - stamps_[item.slot] < ttl / kPromotionsPerTtl;
+    }
+
+    /// Give a newly inserted element a slot
+    void attach(const item_type& item, time_point stamp) {
+        if (!free_.empty()) {
+            item.slot = free_.back();
+            free_.pop_back();
+            stamps_[item.slot] = stamp;
+            return;
+        }
+        if (stamps_.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Too many elements for 32-bit timestamp slots");
+        }
+        item.slot = static_cast<std::uint32_t>(stamps_.size());
+        stamps_.push_back(stamp);
+        if (free_.capacity() < stamps_.capacity()) {
+            free_.reserve(stamps_.capacity());  // detach() never allocates
+        }
+    }
+
+    /// Release the slot of an element leaving the container
+    void detach(const item_type& item) noexcept { free_.push_back(item.slot); }
+
+    /// Carry the slot of an element over to its replacement
+    void adopt(const item_type& from, item_type& to) noexcept { to.slot = from.slot; }
+
+    void clear() noexcept {
+        stamps_.clear();
+        free_.clear();
+    }
+
+    std::size_t bytes() const noexcept {
+        return stamps_.capacity() * sizeof(time_point) + free_.capacity() * sizeof(std::uint32_t);
+    }
+
+private:
+    std::vector<time_point> stamps_;
+    std::vector<std::uint32_t> free_;
+};
+
+/// Generation numbers in GenerationValue nodes, with a ring of element counts per generation
+///
+/// Generations count lengths since the store was created. Nodes keep the low
+/// 32 bits, read back relative to the newest generation; the container drops
+/// elements whose generation is about to become ambiguous (see wrapped()).
+/// Generations older than the ring are counted together in older_.
+template <typename Value>
+class TimestampStore<generation_timestamps, Value> {
+public:
+    using item_type = GenerationValue<Value>;
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    static constexpr std::uint64_t kGenerationsPerTtl = 8;
+    static constexpr std::size_t kMaxRing = 4096;
+
+    TimestampStore() : epoch_(std::chrono::steady_clock::now()), next_roll_(epoch_) {}
+
+    /// Set the generation length from the TTL and size the ring for retention
+    void configure(duration ttl, duration retention) {
+        length_ = std::max(duration(1), ttl / static_cast<duration::rep>(kGenerationsPerTtl));
+        next_roll_ = epoch_ + length_ * static_cast<duration::rep>(newest_ + 1);
+        resize(retention);
+    }
+
+    /// Change the generation length to TTL/8 of a new TTL and move the
+    /// elements to the new generations of their last access
+    ///
+    /// An element still counts as accessed at the start of its old
+    /// generation, so it never expires later than before.
+    template <typename Items>
+    void rebucket(duration ttl, duration retention, const Items& items) {
+        const auto length = std::max(duration(1), ttl / static_cast<duration::rep>(kGenerationsPerTtl));
+        const auto newest = static_cast<std::uint64_t>(length_ * static_cast<duration::rep>(newest_) / length);
+        const auto needed = static_cast<std::size_t>(retention / length) + 3;
+        std::vector<std::size_t> counts(std::min(needed, kMaxRing), 0);
+        const std::uint64_t ring = counts.size();
+        const std::uint64_t base = newest + 1 >= ring ? newest + 1 - ring : 0;
+        // The oldest generation a 32-bit node field still reads back correctly
+        const std::uint64_t oldest = newest >= (std::uint64_t{1} << 31) ? newest - (std::uint64_t{1} << 31) + 1 : 0;
+        std::size_t older = 0;
+        for (const auto& item : items) {
+            auto generation = static_cast<std::uint64_t>(
+                length_ * static_cast<duration::rep>(full(item.generation)) / length);
+            generation = std::max(generation, oldest);
+            if (generation < base) {
+                ++older;
+            } else {
+                ++counts[generation % ring];
+            }
+            item.generation = static_cast<std::uint32_t>(generation);
+        }
+        length_ = length;
+        newest_ = newest;
+        next_roll_ = epoch_ + length_ * static_cast<duration::rep>(newest_ + 1);
+        counts_ = std::move(counts);
+        base_ = base;
+        older_ = older;
+    }
+
+    /// Resize the ring to cover retention (the generation length stays)
+    void resize(duration retention) {
+        const auto needed = static_cast<std::size_t>(retention / length_) + 3;
+        std::vector<std::size_t> counts(std::min(needed, kMaxRing), 0);
+        const std::uint64_t ring = counts.size();
+        const std::uint64_t base = std::max(base_, newest_ + 1 >= ring ? newest_ + 1 - ring : 0);
+        for (std::uint64_t generation = base_; !counts_.empty() && generation <= newest_; ++generation) {
+            const auto count = counts_[generation % counts_.size()];
+            if (generation < base) {
+                older_ += count;
+            } else {
+                counts[generation % ring] += count;
+            }
+        }
+        counts_ = std::move(counts);
+        base_ = base;
+    }
+
+    /// Start of the generation of the element's last access
+    time_point get(const item_type& item) const noexcept {
+        return epoch_ + length_ * static_cast<duration::rep>(full(item.generation));
+    }
+
+    void set(const item_type& item, time_point stamp) noexcept {
+        const auto generation = generation_of(stamp);
+        if (static_cast<std::uint32_t>(generation) == item.generation) {
+            return;  // same generation: leave the node alone
+        }
+        --count(full(item.generation));
+        ++count(generation);
+        item.generation = static_cast<std::uint32_t>(generation);
+    }
+
+    /// Whether the element is in the newest generation, and so keeps its LRU position on a hit
+    bool recent(const item_type& item, time_point, duration) const noexcept {
+        return item.generation == static_cast<std::uint32_t>(newest_);
+    }
+
+    void attach(const item_type& item, time_point stamp) noexcept {
+        const auto generation = generation_of(stamp);
+        ++count(generation);
+        item.generation = static_cast<std::uint32_t>(generation);
+    }
+
+    void detach(const item_type& item) noexcept { --count(full(item.generation)); }
+
+    void adopt(const item_type& from, item_type& to) noexcept { to.generation = from.generation; }
+
+    void clear() noexcept {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        older_ = 0;
+    }
+
+    std::size_t bytes() const noexcept { return counts_.capacity() * sizeof(std::size_t); }
+
+    /// Move the newest generation up to now's
+    /// @return true if a new generation started
+    bool advance(time_point now) noexcept {
+        if (now < next_roll_) {
+            return false;
+        }
+        const auto generation = generation_of(now);
+        const std::uint64_t ring = counts_.size();
+        const std::uint64_t base = generation + 1 >= ring ? generation + 1 - ring : 0;
+        for (auto old = base_; old < base && old < base_ + ring; ++old) {
+            older_ += std::exchange(counts_[old % ring], 0);
+        }
+        base_ = std::max(base_, base);
+        newest_ = generation;
+        next_roll_ = epoch_ + length_ * static_cast<duration::rep>(newest_ + 1);
+        return true;
+    }
+
+    /// Number of elements last accessed more than retention before now, if
+    /// the ring can tell (it cannot when retention outgrew it)
+    std::optional<std::size_t> expired_count(time_point now, duration retention) const noexcept {
+        const auto limit = now - retention - epoch_;
+        if (limit <= duration::zero()) {
+            return 0;
+        }
+        // First generation whose start is at least limit since the epoch
+        const auto cutoff = static_cast<std::uint64_t>((limit + length_ - duration(1)) / length_);
+        if (cutoff < base_) {
+            return std::nullopt;
+        }
+        std::size_t expired = older_;
+        for (auto generation = base_; generation < cutoff && generation <= newest_; ++generation) {
+            expired += counts_[generation % counts_.size()];
+        }
+        return expired;
+    }
+
+    /// Check whether an element is half the 32-bit generation range old
+    bool wrapped(const item_type& item) const noexcept {
+        return static_cast<std::uint32_t>(static_cast<std::uint32_t>(newest_) - item.generation) >=
+               (std::uint32_t{1} << 31);
+    }
+
+private:
+    std::uint64_t generation_of(time_point stamp) const noexcept {
+        return stamp <= epoch_ ? 0 : static_cast<std::uint64_t>((stamp - epoch_) / length_);
+    }
+
+    std::uint64_t full(std::uint32_t generation) const noexcept {
+        return newest_ - static_cast<std::uint32_t>(static_cast<std::uint32_t>(newest_) - generation);
+    }
+
+    std::size_t& count(std::uint64_t generation) noexcept {
+        return generation < base_ ? older_ : counts_[generation % counts_.size()];
+    }
+
+    time_point epoch_;
+    duration length_{1};
+    time_point next_roll_;
+    std::uint64_t newest_ = 0;    // generation of the latest advance()
+    std::uint64_t base_ = 0;      // oldest generation with its own ring entry
+    std::vector<std::size_t> counts_;
+    std::size_t older_ = 0;       // elements in generations before base_
+};
+
+}  // namespace detail
+
 /// @brief MultiIndex LRU container with TTL-based expiration
 ///
 /// Extends Container with time-to-live (TTL) semantics. Items automatically
 /// expire after a configurable duration. Access via find() refreshes the
-/// expiration timer.
+/// expiration timer, unless the container expires after write (see
+/// ExpirationPolicy).
 ///
 /// @tparam Value The value type stored in the container
 /// @tparam IndexSpecifierList boost::multi_index::indexed_by<...> specifying indices
 /// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+/// @tparam TimestampStorage inline_timestamps (default), slot_timestamps or generation_timestamps
 ///
 /// Example usage:
 /// @code
@@ -61,8 +410,16 @@ namespace multi_index_lru {
 /// // Periodic cleanup of expired items
 /// cache.cleanup_expired();
 /// @endcode
-template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>>
+template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>,
+          typename TimestampStorage = inline_timestamps>
 class ExpirableContainer {
+    using Timestamps = detail::TimestampStore<TimestampStorage, Value>;
+    using CacheItem = typename Timestamps::item_type;
+    using CacheContainer = Container<CacheItem, IndexSpecifierList,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<CacheItem>>;
+    static constexpr bool kInlineTimestamps = std::is_same_v<TimestampStorage, inline_timestamps>;
+    static constexpr bool kGenerations = std::is_same_v<TimestampStorage, generation_timestamps>;
+
 public:
     using value_type = Value;
     using allocator_type = Allocator;
@@ -70,35 +427,69 @@ public:
     using clock_type = std::chrono::steady_clock;
     using duration_type = std::chrono::milliseconds;
     using time_point_type = clock_type::time_point;
+    /// Node handle owning an extracted element and, with inline_timestamps, its timestamp (see extract())
+    using node_type = typename CacheContainer::node_type;
 
     /// @brief Construct container with specified capacity and TTL
     /// @param max_size Maximum number of elements before LRU eviction
     /// @param ttl Time-to-live for each element
-    explicit ExpirableContainer(size_type max_size, duration_type ttl)
-        : container_(max_size), ttl_(ttl)
+    /// @param reserve_buckets Size all hashed indices for max_size up front
+    explicit ExpirableContainer(size_type max_size, duration_type ttl, bool reserve_buckets = false)
+        : container_(max_size, reserve_buckets), ttl_(ttl)
     {
         if (ttl.count() <= 0) {
             throw std::invalid_argument("TTL must be positive");
         }
         assert(ttl.count() > 0 && "TTL must be positive");
+        if constexpr (kGenerations) {
+            timestamps_.configure(ttl, retention_period());
+        }
+    }
+
+    /// @brief Construct container with specified capacity, TTL and expiration policy
+    /// @param max_size Maximum number of elements before LRU eviction
+    /// @param ttl Time-to-live for each element
+    /// @param policy ExpirationPolicy::after_write for data that must be
+    ///        refetched periodically however often it is read
+    /// @param reserve_buckets Size all hashed indices for max_size up front
+    ///
+    /// With after_write, hits still move elements to the front of the LRU
+    /// order but leave the timestamp alone, so the read path does not store
+    /// to it, and an element expires one TTL after it was written.
+    /// generation_timestamps only supports after_access (throws
+    /// std::invalid_argument otherwise).
+    ExpirableContainer(size_type max_size, duration_type ttl, ExpirationPolicy policy,
+                       bool reserve_buckets = false)
+        : ExpirableContainer(max_size, ttl, reserve_buckets)
+    {
+        if (kGenerations && policy != ExpirationPolicy::after_access) {
+            throw std::invalid_argument("generation_timestamps requires ExpirationPolicy::after_access");
+        }
+        policy_ = policy;
     }
 
     /// @brief Emplace a new element
     /// @param args Arguments forwarded to value constructor
     /// @return Pair of (wrapped iterator, bool indicating new insertion)
     ///
-    /// If an element with matching key(s) exists, its timestamp is refreshed.
+    /// If an element with matching key(s) exists, its timestamp is refreshed
+    /// (ExpirationPolicy::after_access only; the value is not replaced).
     template <typename... Args>
     auto emplace(Args&&... args) {
+        const auto now = current_time();
         auto result = container_.get_sequenced().emplace_front(
             CacheItem{Value{std::forward<Args>(args)...}});
 
         if (!result.second) {
-            result.first->last_accessed = clock_type::now();
+            touch(*result.first, now);
             container_.get_sequenced().relocate(
                 container_.get_sequenced().begin(), result.first);
-        } else if (container_.size() > container_.capacity()) {
-            container_.get_sequenced().pop_back();
+        } else {
+            attach_new(*result.first, now);
+            container_.account_insert(*result.first);
+            if (container_.size() > container_.capacity()) {
+                evict_lru();
+            }
         }
 
         return std::pair{detail::TimestampedIteratorWrapper{result.first}, result.second};
@@ -114,36 +505,203 @@ public:
     /// @return true if newly inserted, false if existing element was refreshed
     bool insert(Value&& value) { return emplace(std::move(value)).second; }
 
+    /// @brief Insert an extracted element, keeping its timestamp
+    /// @param node Node handle from extract() of a container of the same type
+    /// @return true if inserted, false if node was empty, the element outlived
+    ///         this container's TTL and stale windows, or an element with
+    ///         matching key(s) exists (node then keeps the element)
+    ///
+    /// The element keeps its last access time, so it expires one TTL of this
+    /// container after its last access in the source. It goes behind the
+    /// elements accessed after it, keeping the LRU order sorted by timestamp
+    /// for cleanup_expired(); the position is found by walking from both
+    /// ends at once, so the cost grows with the distance to the nearer end,
+    /// and in a full container an element older than all others is evicted
+    /// right away.
+    /// With slot_timestamps or generation_timestamps the timestamp stays
+    /// behind in the source, and the element's TTL restarts here at the
+    /// front. A matching element is refreshed and moves to the front, as
+    /// with insert(const Value&).
+    bool insert(node_type&& node) {
+        if (node.empty()) {
+            return false;
+        }
+        const auto now = current_time();
+        auto& seq_index = container_.get_sequenced();
+        auto position = seq_index.begin();
+        if constexpr (kInlineTimestamps) {
+            const auto stamp = node.value().last_accessed;
+            if (now > stamp + retention_period()) {
+                return false;
+            }
+            // The walk from the front stops at the first element not newer
+            // than the node, the one from the back behind the last one not older
+            auto back = seq_index.end();
+            while (position != back && timestamp(*position) > stamp) {
+                ++position;
+                if (position == back || timestamp(*std::prev(back)) >= stamp) {
+                    position = back;
+                    break;
+                }
+                --back;
+            }
+        }
+        auto result = seq_index.insert(position, std::move(node));
+        if (!result.inserted) {
+            touch(*result.position, now);
+            seq_index.relocate(seq_index.begin(), result.position);
+            node = std::move(result.node);
+            return false;
+        }
+        if constexpr (!kInlineTimestamps) {
+            attach_new(*result.position, now);
+        }
+        container_.account_insert(*result.position);
+        if (container_.size() > container_.capacity()) {
+            evict_lru();
+        }
+        return true;
+    }
+
+    /// @brief Insert a value, or overwrite the element with the same key
+    /// @param value Value to store
+    /// @return true if newly inserted, false if an existing element was overwritten
+    ///
+    /// The element is matched on the first index. Unlike insert(), an
+    /// existing element's value is replaced, and its timestamp restarts, so a
+    /// stale element becomes fresh again. Throws std::invalid_argument if the
+    /// value collides with a different element on another unique index.
+    bool insert_or_assign(Value value) {
+        const auto now = current_time();
+        const auto result = assign(container_.get_container().template get<1>(), CacheItem{std::move(value)}, now);
+        if (result == AssignResult::collided) {
+            throw std::invalid_argument("Value collides with another element");
+        }
+        return result == AssignResult::inserted;
+    }
+
     /// @brief Find element by key, checking TTL and refreshing timestamp
     /// @tparam Tag Index tag type
     /// @param key Key to search for
     /// @return Wrapped iterator to found element, or end() if not found or expired
     ///
     /// If the element is found but expired, it is removed and end() is returned.
-    /// If found and not expired, the access timestamp is refreshed.
+    /// If found and not expired, the access timestamp is refreshed (under
+    /// ExpirationPolicy::after_access) and it moves to the front (at most once
+    /// per TTL/8 with slot_timestamps, or per generation with
+    /// generation_timestamps). With a StalePolicy, expired elements
+    /// are kept until the stale windows end.
     template <typename Tag, typename Key = void>
     auto find(const auto& key) {
-        auto now = clock_type::now();
+        auto now = current_time();
         auto& index = container_.template get_index<Tag>();
         auto it = index.find(key);
         
         if (it != index.end()) {
-            if (now > it->last_accessed + ttl_) {
-                // Item expired - remove it
-                index.erase(it);
+            if (now > timestamp(*it) + ttl_) {
+                // Item expired - remove it unless a stale window still covers it
+                erase_if_unretained(it, now);
                 return detail::TimestampedIteratorWrapper{index.end()};
             } else {
                 // Refresh timestamp and move to front
-                it->last_accessed = now;
-                container_.get_sequenced().relocate(
-                    container_.get_sequenced().begin(),
-                    container_.get_container().template project<0>(it));
+                promote(it, now);
             }
         }
         
         return detail::TimestampedIteratorWrapper{it};
     }
 
+    /// @brief Find element by key, serving it past its TTL within the stale-while-revalidate window
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @return Iterator and freshness: fresh (timestamp refreshed, as find()),
+    ///         stale (expired up to stale_while_revalidate ago) or missing
+    ///
+    /// A stale element keeps its timestamp and its LRU position, so it stays
+    /// stale (and first in line for eviction) until the caller replaces it,
+    /// e.g. with insert_or_assign() once a background refresh completes. Meanwhile
+    /// readers keep getting the old value instead of missing, and a
+    /// backend brownout does not turn every lookup into a miss.
+    template <typename Tag>
+    auto find_allow_stale(const auto& key) {
+        using iterator = detail::TimestampedIteratorWrapper<
+            typename std::remove_reference_t<decltype(container_.template get_index<Tag>())>::iterator>;
+        auto now = current_time();
+        auto& index = container_.template get_index<Tag>();
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return StaleLookup<iterator>{iterator{it}, Freshness::missing};
+        }
+        if (now <= timestamp(*it) + ttl_) {
+            promote(it, now);
+            return StaleLookup<iterator>{iterator{it}, Freshness::fresh};
+        }
+        if (now <= timestamp(*it) + ttl_ + stale_policy_.stale_while_revalidate) {
+            return StaleLookup<iterator>{iterator{it}, Freshness::stale};
+        }
+        erase_if_unretained(it, now);
+        return StaleLookup<iterator>{iterator{index.end()}, Freshness::missing};
+    }
+
+    /// @brief Find element by key, loading it when missing or expired
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @param loader Called as loader(key) on a miss; returns the Value, or a
+    ///        std::optional<Value> that is empty on failure, or throws
+    /// @return Iterator and freshness: fresh (found, or loaded and stored),
+    ///         stale (the loader failed and the element expired at most
+    ///         stale_if_error ago) or missing
+    ///
+    /// A loaded value replaces the expired element (see insert_or_assign()).
+    /// A value that does not have key `key` on the Tag index, or that
+    /// collides with another element on a unique index, is dropped and
+    /// handled as a failed load. If the loader fails and no stale element can
+    /// be served, an exception from it is rethrown. The loader must not
+    /// modify this container.
+    template <typename Tag, typename Loader>
+    auto get_or_load(const auto& key, Loader&& loader) {
+        using iterator = detail::TimestampedIteratorWrapper<
+            typename std::remove_reference_t<decltype(container_.template get_index<Tag>())>::iterator>;
+        auto now = current_time();
+        auto& index = container_.template get_index<Tag>();
+        auto it = index.find(key);
+        if (it != index.end() && now <= timestamp(*it) + ttl_) {
+            promote(it, now);
+            return StaleLookup<iterator>{iterator{it}, Freshness::fresh};
+        }
+
+        std::optional<Value> loaded;
+        std::exception_ptr error;
+        try {
+            loaded = std::invoke(std::forward<Loader>(loader), key);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (loaded) {
+            CacheItem item{std::move(*loaded)};
+            if (has_key(index, item, key) &&
+                assign(index, std::move(item), current_time()) != AssignResult::collided) {
+                auto stored = index.find(key);
+                return StaleLookup<iterator>{
+                    iterator{stored}, stored != index.end() ? Freshness::fresh : Freshness::missing};
+            }
+            // Unusable value: handled as a failed load (current_time() may
+            // have evicted, so look the old element up again)
+            it = index.find(key);
+        }
+
+        if (it != index.end()) {
+            if (now <= timestamp(*it) + ttl_ + stale_policy_.stale_if_error) {
+                return StaleLookup<iterator>{iterator{it}, Freshness::stale};
+            }
+            erase_if_unretained(it, now);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return StaleLookup<iterator>{iterator{index.end()}, Freshness::missing};
+    }
+
     /// @brief Find element without updating timestamp or checking TTL
     /// @tparam Tag Index tag type
     /// @param key Key to search for
@@ -175,7 +733,7 @@ public:
     /// have their timestamps refreshed.
     template <typename Tag, typename Key = void>
     auto equal_range(const auto& key) {
-        auto now = clock_type::now();
+        auto now = current_time();
         auto& index = container_.template get_index<Tag>();
         auto range = index.equal_range(key);
         
@@ -183,14 +741,11 @@ public:
         bool changed = false;
         
         while (it != range.second) {
-            if (now > it->last_accessed + ttl_) {
-                it = index.erase(it);
+            if (now > timestamp(*it) + ttl_) {
+                it = erase_item(it);
                 changed = true;
             } else {
-                it->last_accessed = now;
-                container_.get_sequenced().relocate(
-                    container_.get_sequenced().begin(),
-                    container_.get_container().template project<0>(it));
+                promote(it, now);
                 ++it;
             }
         }
@@ -246,15 +801,74 @@ public:
         return this->template find_no_update<Tag, Key>(key) != this->template end<Tag>();
     }
 
+    /// @brief Modify element in place, checking TTL and refreshing timestamp
+    /// @tparam Tag Index tag type
+    /// @param key Key of element to modify
+    /// @param modifier Called as modifier(Value&)
+    /// @return true if the element was modified and is still in the container,
+    ///         false if not found, expired (and removed) or erased by the modification
+    ///
+    /// Same semantics as Container::modify(); an expired element is removed
+    /// (unless a stale window covers it) without calling the modifier.
+    template <typename Tag, typename Modifier>
+    bool modify(const auto& key, Modifier&& modifier) {
+        auto now = current_time();
+        auto& index = container_.template get_index<Tag>();
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return false;
+        }
+        if (now > timestamp(*it) + ttl_) {
+            erase_if_unretained(it, now);
+            return false;
+        }
+        // The element is erased if the modification collides on a unique index
+        timestamps_.detach(*it);
+        if (!container_.modify(it, [&modifier](CacheItem& item) { modifier(item.value); })) {
+            return false;
+        }
+        timestamps_.attach(*it, stamp(*it, now));
+        return true;
+    }
+
     /// @brief Erase element by key
     /// @tparam Tag Index tag type
     /// @param key Key of element to erase
     /// @return true if element was erased, false if not found
     template <typename Tag, typename Key = void>
     bool erase(const auto& key) {
+        if constexpr (!kInlineTimestamps) {
+            auto [first, last] = container_.template get_index<Tag>().equal_range(key);
+            for (auto it = first; it != last; ++it) {
+                timestamps_.detach(*it);
+            }
+        }
         return container_.template erase<Tag>(key);
     }
 
+    /// @brief Remove a live element and return it, with its timestamp, in a node handle
+    /// @tparam Tag Index tag type
+    /// @param key Key of element to extract
+    /// @return Node handle owning the element (node.value().value is the
+    ///         Value), or an empty handle if not found or expired
+    ///
+    /// An expired element is removed instead of extracted.
+    template <typename Tag>
+    node_type extract(const auto& key) {
+        const auto now = current_time();
+        auto& index = container_.template get_index<Tag>();
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return node_type();
+        }
+        if (now > timestamp(*it) + ttl_) {
+            erase_if_unretained(it, now);
+            return node_type();
+        }
+        timestamps_.detach(*it);
+        return container_.extract(it);
+    }
+
     /// @brief Get current number of elements (including expired)
     [[nodiscard]] size_type size() const noexcept { return container_.size(); }
 
@@ -267,11 +881,60 @@ public:
     /// @brief Set new capacity
     /// @param new_capacity New maximum size
     void set_capacity(size_type new_capacity) {
+        if (new_capacity != 0) {
+            while (container_.size() > new_capacity) {
+                evict_lru();
+            }
+        }
         container_.set_capacity(new_capacity);
     }
 
     /// @brief Remove all elements
-    void clear() noexcept { container_.clear(); }
+    void clear() noexcept {
+        container_.clear();
+        timestamps_.clear();
+    }
+
+    /// @brief Evict the least recently used element, expired or not
+    /// @return true if an element was evicted, false if the container is empty
+    bool evict_lru() {
+        if (container_.empty()) {
+            return false;
+        }
+        timestamps_.detach(container_.get_sequenced().back());
+        return container_.evict_lru();
+    }
+
+    /// @brief Get when the least recently used element was last accessed
+    /// @return Its timestamp, or std::nullopt if the container is empty
+    [[nodiscard]] std::optional<time_point_type> lru_last_accessed() const noexcept {
+        const auto& seq_index = container_.get_sequenced();
+        if (seq_index.empty()) {
+            return std::nullopt;
+        }
+        return timestamps_.get(seq_index.back());
+    }
+
+    /// @brief Get the bytes used by the container (see Container::memory_usage())
+    ///
+    /// Node values include each element's timestamp (or slot, or
+    /// generation); payload is measured when heap_bytes() is available for
+    /// Value. The slot_timestamps array and the generation_timestamps ring
+    /// count as index links.
+    [[nodiscard]] MemoryUsage memory_usage() const noexcept {
+        auto usage = container_.memory_usage();
+        usage.index_links += timestamps_.bytes();
+        return usage;
+    }
+
+    /// @brief Size every hashed index to hold n elements without rehashing
+    void reserve(size_type n) { container_.reserve(n); }
+
+    /// @brief Get the max load factor applied to hashed indices
+    [[nodiscard]] float max_load_factor() const noexcept { return container_.max_load_factor(); }
+
+    /// @brief Set the max load factor of every hashed index
+    void max_load_factor(float z) { container_.max_load_factor(z); }
 
     /// @brief Get end iterator for specified index
     /// @tparam Tag Index tag type
@@ -292,14 +955,35 @@ public:
     ///
     /// Scans from the back (oldest) and removes consecutive expired items.
     /// Call periodically to prevent memory bloat from expired entries.
+    /// Elements still inside a stale window are kept. With TTL jitter,
+    /// timestamps are only ordered up to the jitter, so an expired element
+    /// may stay behind an unexpired one for up to the jitter longer.
+    /// Under ExpirationPolicy::after_write, hits reorder elements without
+    /// restamping them, so an expired element that was read recently stays
+    /// until its next lookup or eviction. With slot_timestamps, elements hit
+    /// within TTL/8 are restamped without moving, so an expired element may
+    /// likewise stay up to TTL/8 longer. With generation_timestamps the
+    /// number of expired elements is read from per-generation counts and
+    /// they are evicted without comparing timestamps.
     void cleanup_expired() {
-        auto now = clock_type::now();
+        auto now = current_time();
         auto& seq_index = container_.get_sequenced();
+        const auto retention = retention_period();
+
+        if constexpr (kGenerations) {
+            // The expired elements are the last expired_count() in LRU order
+            if (const auto expired = timestamps_.expired_count(now, retention)) {
+                for (std::size_t i = 0; i < *expired; ++i) {
+                    evict_lru();
+                }
+                return;
+            }
+        }
 
         while (!seq_index.empty()) {
             auto it = seq_index.rbegin();
-            if (now > it->last_accessed + ttl_) {
-                seq_index.pop_back();
+            if (now > timestamp(*it) + retention) {
+                evict_lru();
             } else {
                 break;
             }
@@ -310,21 +994,240 @@ public:
     [[nodiscard]] duration_type ttl() const noexcept { return ttl_; }
 
     /// @brief Set new TTL (affects future accesses, not existing timestamps)
+    ///
+    /// With generation_timestamps the generation length becomes TTL/8 of the
+    /// new TTL, and every element moves to the new generation its last
+    /// access falls in (one pass over the elements). An element keeps
+    /// counting as accessed at the start of its old generation, so after a
+    /// shrink it may expire up to the old generation length early.
     void set_ttl(duration_type new_ttl) {
         if (new_ttl.count() <= 0) {
             throw std::invalid_argument("TTL must be positive");
         }
+        if (new_ttl <= jitter_) {
+            throw std::invalid_argument("TTL must exceed the TTL jitter");
+        }
         assert(new_ttl.count() > 0 && "TTL must be positive");
         ttl_ = new_ttl;
+        if constexpr (kGenerations) {
+            timestamps_.rebucket(ttl_, retention_period(), container_.get_sequenced());
+        }
+    }
+
+    /// @brief Get what restarts an element's TTL
+    [[nodiscard]] ExpirationPolicy expiration_policy() const noexcept { return policy_; }
+
+    /// @brief Get the stale-while-revalidate and stale-if-error windows
+    [[nodiscard]] const StalePolicy& stale_policy() const noexcept { return stale_policy_; }
+
+    /// @brief Set the windows in which expired elements are still served
+    /// @param policy Windows past the TTL (zero disables them, the default)
+    void set_stale_policy(StalePolicy policy) {
+        if (policy.stale_while_revalidate.count() < 0 || policy.stale_if_error.count() < 0) {
+            throw std::invalid_argument("Stale windows must not be negative");
+        }
+        stale_policy_ = policy;
+        if constexpr (kGenerations) {
+            timestamps_.resize(retention_period());
+        }
+    }
+
+    /// @brief Get the TTL jitter
+    [[nodiscard]] duration_type ttl_jitter() const noexcept { return jitter_; }
+
+    /// @brief Get how jitter offsets are chosen
+    [[nodiscard]] JitterMode jitter_mode() const noexcept { return jitter_mode_; }
+
+    /// @brief Spread expiration times by shortening each element's TTL by up to jitter
+    /// @param jitter Largest offset (zero disables jitter, the default); must be below the TTL
+    /// @param mode JitterMode::random draws an offset at every timestamp write;
+    ///        JitterMode::per_key derives a fixed one from the first index's key
+    ///
+    /// Elements loaded together otherwise expire together: a burst of misses
+    /// hits the backend at once and cleanup_expired() has a long run. With
+    /// jitter, each element expires uniformly within [ttl - jitter, ttl] of
+    /// its last access. The offset is folded into the stored timestamp, so
+    /// it costs no memory; last access times read back are earlier by it.
+    /// per_key requires the key to be std::hash-able and makes every
+    /// replica of a key expire at the same point (throws
+    /// std::invalid_argument otherwise). Applies from the next timestamp write.
+    /// Not supported with generation_timestamps, which already spreads
+    /// expirations over a generation.
+    void set_ttl_jitter(duration_type jitter, JitterMode mode = JitterMode::random) {
+        if (jitter.count() < 0 || jitter >= ttl_) {
+            throw std::invalid_argument("TTL jitter must be non-negative and below the TTL");
+        }
+        if (kGenerations && jitter.count() != 0) {
+            throw std::invalid_argument("TTL jitter is not supported with generation_timestamps");
+        }
+        if (mode == JitterMode::per_key && !kKeyHashable) {
+            throw std::invalid_argument("Per-key TTL jitter requires a std::hash-able key");
+        }
+        jitter_ = jitter;
+        jitter_mode_ = mode;
     }
 
 private:
-    using CacheItem = detail::TimestampedValue<Value>;
-    using CacheContainer = Container<CacheItem, IndexSpecifierList, 
-        typename std::allocator_traits<Allocator>::template rebind_alloc<CacheItem>>;
+
+    using boost_container = std::remove_cvref_t<decltype(std::declval<CacheContainer&>().get_container())>;
+    using key_index_type = typename boost_container::template nth_index<1>::type;
+    using key_type = typename key_index_type::key_type;
+
+    static constexpr bool kKeyHashable = requires(const key_type& key) {
+        { std::hash<key_type>{}(key) } -> std::convertible_to<std::size_t>;
+    };
+
+    /// Timestamp to store for an access at now: now minus the jitter offset
+    time_point_type stamp(const CacheItem& item, time_point_type now) noexcept {
+        if (jitter_.count() == 0) {
+            return now;
+        }
+        const auto span = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<clock_type::duration>(jitter_).count()) + 1;
+        std::uint64_t bits = 0;
+        if constexpr (kKeyHashable) {
+            if (jitter_mode_ == JitterMode::per_key) {
+                const auto& key_index = container_.get_container().template get<1>();
+                bits = detail::mix_hash(std::hash<key_type>{}(key_index.key_extractor()(item)));
+            }
+        }
+        if (jitter_mode_ == JitterMode::random) {
+            jitter_state_ += 0x9e3779b97f4a7c15ULL;  // splitmix64
+            bits = detail::mix_hash(jitter_state_);
+        }
+        return now - clock_type::duration(static_cast<clock_type::rep>(bits % span));
+    }
+
+    /// Restart the TTL of an element that was hit, unless expiring after write
+    void touch(const CacheItem& item, time_point_type now) noexcept {
+        if (policy_ == ExpirationPolicy::after_access) {
+            timestamps_.set(item, stamp(item, now));
+        }
+    }
+
+    /// Restart the TTL of an element that was hit and move it to the front of the LRU order
+    ///
+    /// An element the store reports as recently accessed keeps its position,
+    /// so the hit does not write its index links (see slot_timestamps and
+    /// generation_timestamps).
+    template <typename Iterator>
+    void promote(Iterator it, time_point_type now) {
+        const bool recent = policy_ == ExpirationPolicy::after_access &&
+                            timestamps_.recent(*it, now, ttl_);
+        touch(*it, now);
+        if (!recent) {
+            move_to_front(it);
+        }
+    }
+
+    time_point_type timestamp(const CacheItem& item) const noexcept { return timestamps_.get(item); }
+
+    /// Read the clock; with generation_timestamps, also start a new generation when due
+    ///
+    /// Called on entry to public members, before iterators are taken: it may evict.
+    time_point_type current_time() {
+        const auto now = clock_type::now();
+        if constexpr (kGenerations) {
+            if (timestamps_.advance(now)) {
+                // Elements 2^31 generations old would read back as new; they
+                // are at the LRU tail and long expired
+                auto& seq_index = container_.get_sequenced();
+                while (!seq_index.empty() && timestamps_.wrapped(seq_index.back())) {
+                    evict_lru();
+                }
+            }
+        }
+        return now;
+    }
+
+    /// Set the timestamp of a newly inserted element
+    void attach_new(const CacheItem& item, time_point_type now) {
+        if constexpr (!kInlineTimestamps) {
+            timestamps_.attach(item, stamp(item, now));
+        } else if (jitter_.count() != 0) {
+            // Constructed with the current time
+            item.last_accessed = stamp(item, item.last_accessed);
+        }
+    }
+
+    template <typename Iterator>
+    Iterator erase_item(Iterator it) {
+        timestamps_.detach(*it);
+        return container_.erase(it);
+    }
+
+    /// How long after its last access an element is kept
+    duration_type retention_period() const noexcept {
+        return ttl_ + std::max(stale_policy_.stale_while_revalidate, stale_policy_.stale_if_error);
+    }
+
+    template <typename Iterator>
+    void move_to_front(Iterator it) {
+        container_.get_sequenced().relocate(
+            container_.get_sequenced().begin(),
+            container_.get_container().template project<0>(it));
+    }
+
+    /// Erase an expired element unless a stale window still covers it
+    template <typename Iterator>
+    void erase_if_unretained(Iterator it, time_point_type now) {
+        if (now > timestamp(*it) + retention_period()) {
+            erase_item(it);
+        }
+    }
+
+    /// Whether item's key on index is equivalent to key, by the index's own
+    /// equality (hashed) or ordering (ordered)
+    template <typename Index>
+    static bool has_key(const Index& index, const CacheItem& item, const auto& key) {
+        const auto item_key = index.key_extractor()(item);
+        if constexpr (requires { index.key_eq(); }) {
+            return index.key_eq()(item_key, key);
+        } else {
+            const auto& less = index.key_comp();
+            return !less(item_key, key) && !less(key, item_key);
+        }
+    }
+
+    enum class AssignResult { inserted, replaced, collided };
+
+    /// Overwrite the element with item's key on index, or insert item; on a
+    /// collision with another element the container is left unchanged
+    template <typename Index>
+    AssignResult assign(Index& index, CacheItem item, time_point_type now) {
+        auto it = index.find(index.key_extractor()(item));
+        if (it != index.end()) {
+            timestamps_.adopt(*it, item);
+            container_.account_erase(*it);
+            if (!index.replace(it, std::move(item))) {
+                container_.account_insert(*it);
+                return AssignResult::collided;
+            }
+            timestamps_.set(*it, stamp(*it, now));
+            container_.account_insert(*it);
+            move_to_front(it);
+            return AssignResult::replaced;
+        }
+        auto& seq_index = container_.get_sequenced();
+        if (!seq_index.push_front(std::move(item)).second) {
+            return AssignResult::collided;
+        }
+        attach_new(seq_index.front(), now);
+        container_.account_insert(seq_index.front());
+        if (container_.size() > container_.capacity()) {
+            evict_lru();
+        }
+        return AssignResult::inserted;
+    }
 
     CacheContainer container_;
+    [[no_unique_address]] Timestamps timestamps_;
     duration_type ttl_;
+    ExpirationPolicy policy_ = ExpirationPolicy::after_access;
+    StalePolicy stale_policy_;
+    duration_type jitter_{0};
+    JitterMode jitter_mode_ = JitterMode::random;
+    std::uint64_t jitter_state_ = reinterpret_cast<std::uintptr_t>(this);
 };
 
 }  // namespace multi_index_lru
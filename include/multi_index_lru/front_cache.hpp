@@ -0,0 +1,209 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/front_cache.hpp
+/// @brief Small per-thread cache (L0) in front of a ShardedContainer
+
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief Two-way set-associative cache of a ShardedContainer's hottest keys
+///
+/// A FrontCache is owned by a single thread (typically `thread_local`) and
+/// answers repeated lookups of the same keys without taking the shard lock.
+/// Every entry remembers the version of the shard it was copied from; a hit
+/// is only served while that shard has not been modified since, so data
+/// written through the shared container is never served stale. Writes to a
+/// shard invalidate all of that shard's entries, which makes the front cache
+/// pay off for read-mostly hot sets.
+///
+/// L0 hits do not refresh the element in the shared LRU order. To keep hot
+/// keys from being evicted there, an entry is refilled from the shared
+/// container (refreshing its LRU position) once it is older than max_age.
+///
+/// @tparam Shared ShardedContainer type
+/// @tparam Tag Tag of the first index of Shared (the one elements are routed by)
+///
+/// Example usage:
+/// @code
+/// SharedCache cache(1'000'000, 16);
+///
+/// // On each reader thread
+/// thread_local multi_index_lru::FrontCache<SharedCache, KeyTag> front(cache, 1024);
+/// if (const MyValue* hit = front.find("key1")) {
+///     use(*hit);  // valid until the next call on `front`
+/// }
+/// @endcode
+template <typename Shared, typename Tag>
+class FrontCache {
+    static_assert(Shared::template is_routed_tag<Tag>,
+                  "FrontCache requires the tag of the first index");
+
+public:
+    using value_type = typename Shared::value_type;
+    using key_type = typename Shared::route_key_type;
+    using size_type = std::size_t;
+    using clock_type = std::chrono::steady_clock;
+    using duration_type = clock_type::duration;
+
+    /// @brief Construct a front cache for given shared container
+    /// @param shared Container to read through; must outlive the front cache
+    /// @param slots Number of entries, rounded up to a power of two (at least 2)
+    /// @param max_age Longest time an entry is served without consulting
+    ///                `shared`; duration_type::max() disables the bound
+    FrontCache(Shared& shared, size_type slots,
+               duration_type max_age = std::chrono::milliseconds(100))
+        : shared_(shared), max_age_(max_age)
+    {
+        if (slots == 0) {
+            throw std::invalid_argument("Front cache size must be greater than 0");
+        }
+        if (max_age <= duration_type::zero()) {
+            throw std::invalid_argument("Front cache max age must be positive");
+        }
+        size_type sets = 1;
+        while (sets * kWays < slots) {
+            sets *= 2;
+        }
+        slots_.resize(sets * kWays);
+        victims_.resize(sets, 0);
+        set_mask_ = sets - 1;
+    }
+
+    FrontCache(const FrontCache&) = delete;
+    FrontCache& operator=(const FrontCache&) = delete;
+
+    /// @brief Find element by key
+    /// @param key Key of the first index
+    /// @return Pointer to a private copy of the element, or nullptr if it is
+    ///         not in the shared container. Valid until the next call on this
+    ///         front cache.
+    const value_type* find(const key_type& key) {
+        const auto hash = routing::hash_key(key);
+        const auto set = set_of(hash);
+        const auto now = max_age_ == duration_type::max() ? clock_type::time_point{} : clock_type::now();
+
+        for (size_type way = 0; way < kWays; ++way) {
+            auto& slot = slots_[set * kWays + way];
+            if (!slot.value || slot.hash != hash || !key_equal(*slot.value, key)) {
+                continue;
+            }
+            if (is_fresh(slot, now)) {
+                ++hits_;
+                victims_[set] = static_cast<std::uint8_t>(way ^ 1U);
+                return &*slot.value;
+            }
+            slot.value.reset();
+        }
+
+        ++misses_;
+        auto& slot = slots_[set * kWays + victims_[set]];
+        victims_[set] ^= 1U;
+
+        // Read the version before copying: a write racing with the copy then
+        // makes the entry look stale rather than making stale data look fresh
+        const auto shard = shared_.shard_index_for_key(key);
+        slot.version = shared_.shard_version(shard);
+        slot.shard = shard;
+        slot.hash = hash;
+        slot.filled_at = now;
+        slot.value.reset();
+        shared_.template visit<Tag>(key, [&slot](const value_type& value) { slot.value = value; });
+        return slot.value ? &*slot.value : nullptr;
+    }
+
+    /// @brief Check if element exists by key
+    bool contains(const key_type& key) { return find(key) != nullptr; }
+
+    /// @brief Drop the entry for given key, if cached
+    void invalidate(const key_type& key) {
+        const auto hash = routing::hash_key(key);
+        const auto set = set_of(hash);
+        for (size_type way = 0; way < kWays; ++way) {
+            auto& slot = slots_[set * kWays + way];
+            if (slot.value && slot.hash == hash && key_equal(*slot.value, key)) {
+                slot.value.reset();
+            }
+        }
+    }
+
+    /// @brief Drop all entries
+    void clear() {
+        for (auto& slot : slots_) {
+            slot.value.reset();
+        }
+    }
+
+    /// @brief Get number of slots
+    [[nodiscard]] size_type capacity() const noexcept { return slots_.size(); }
+
+    /// @brief Get maximum age of a served entry
+    [[nodiscard]] duration_type max_age() const noexcept { return max_age_; }
+
+    /// @brief Get number of lookups answered without the shared container
+    [[nodiscard]] std::uint64_t hits() const noexcept { return hits_; }
+
+    /// @brief Get number of lookups forwarded to the shared container
+    [[nodiscard]] std::uint64_t misses() const noexcept { return misses_; }
+
+private:
+    using routing = detail::shard_routing<typename Shared::shard_type>;
+
+    static constexpr size_type kWays = 2;
+
+    struct Slot {
+        std::optional<value_type> value;
+        std::uint64_t hash = 0;
+        std::uint64_t version = 0;
+        size_type shard = 0;
+        clock_type::time_point filled_at;
+    };
+
+    size_type set_of(std::uint64_t hash) const noexcept {
+        // Low bits pick the shard; use the high half for the set
+        return static_cast<size_type>(hash >> 32U) & set_mask_;
+    }
+
+    static bool key_equal(const value_type& value, const key_type& key) {
+        return std::equal_to<key_type>{}(typename routing::key_from_value{}(value), key);
+    }
+
+    bool is_fresh(const Slot& slot, clock_type::time_point now) const noexcept {
+        if (max_age_ != duration_type::max() && now - slot.filled_at > max_age_) {
+            return false;
+        }
+        return shared_.shard_version(slot.shard) == slot.version;
+    }
+
+    Shared& shared_;
+    duration_type max_age_;
+    std::vector<Slot> slots_;
+    std::vector<std::uint8_t> victims_;
+    size_type set_mask_ = 0;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,277 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/ingest_pipeline.hpp
+/// @brief Two-stage ingest: parallel entry building, in-order delivery to the cache owner
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief Bounded pipeline that builds entries on worker threads
+///
+/// Stage 1 runs on a pool of workers: every submitted batch of inputs (e.g.
+/// serialized messages) is turned into values with the build function
+/// (typically `EntryBuilder::build<Deserializer>` or `SbeEntryBuilder::build`).
+/// Stage 2 runs on the thread that owns the cache: poll() and drain() hand the
+/// built values to a sink in submission order, so the cache sees exactly the
+/// sequence of inserts it would have seen without the pipeline.
+///
+/// At most max_in_flight batches are submitted but not yet delivered. When
+/// the pipeline is full, try_submit() fails, submit() blocks, and
+/// submit(batch, sink) delivers finished batches while it waits (for owners
+/// that both receive messages and insert them).
+///
+/// Inputs are moved into the pipeline; when they are non-owning (spans), the
+/// bytes must stay valid until the batch has been delivered.
+///
+/// @tparam Input Input element type (e.g. std::vector<uint8_t> or std::span<const uint8_t>)
+/// @tparam Value Built value type, e.g. the cache's entry type
+///
+/// Example usage:
+/// @code
+/// multi_index_lru::IngestPipeline<std::span<const uint8_t>, Entry> pipeline(
+///     [&builder](std::span<const uint8_t> bytes) { return builder.build(bytes); },
+///     4,    // workers
+///     16);  // batches in flight
+///
+/// // Feed handler thread, which also owns the cache
+/// auto insert = [&cache](Entry&& entry) { cache.insert(std::move(entry)); };
+/// while (auto batch = receive_batch()) {
+///     pipeline.submit(std::move(*batch), insert);
+///     pipeline.poll(insert);
+/// }
+/// pipeline.drain(insert);
+/// @endcode
+template <typename Input, typename Value>
+class IngestPipeline {
+public:
+    using input_type = Input;
+    using value_type = Value;
+    using batch_type = std::vector<Input>;
+    using size_type = std::size_t;
+    using build_function = std::function<Value(const Input&)>;
+
+    /// @brief Start the worker pool
+    /// @param build Called as build(input) on worker threads; must be thread-safe
+    /// @param workers Number of worker threads (must be positive)
+    /// @param max_in_flight Batches submitted but not yet delivered (must be positive)
+    IngestPipeline(build_function build, size_type workers, size_type max_in_flight)
+        : build_(std::move(build)), max_in_flight_(max_in_flight)
+    {
+        if (workers == 0) {
+            throw std::invalid_argument("Worker count must be greater than 0");
+        }
+        if (max_in_flight == 0) {
+            throw std::invalid_argument("Pipeline capacity must be greater than 0");
+        }
+        workers_.reserve(workers);
+        for (size_type i = 0; i < workers; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    /// @brief Stop workers; batches not yet delivered are discarded
+    ~IngestPipeline() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        work_available_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// @brief Submit a batch if the pipeline has room
+    /// @return false if max_in_flight batches are already in flight
+    bool try_submit(batch_type batch) {
+        std::unique_lock lock(mutex_);
+        if (in_order_.size() >= max_in_flight_) {
+            return false;
+        }
+        enqueue(std::move(batch), lock);
+        return true;
+    }
+
+    /// @brief Submit a batch, waiting for room
+    ///
+    /// Another thread must be delivering batches, or this blocks forever.
+    void submit(batch_type batch) {
+        std::unique_lock lock(mutex_);
+        progress_.wait(lock, [this] { return in_order_.size() < max_in_flight_; });
+        enqueue(std::move(batch), lock);
+    }
+
+    /// @brief Submit a batch, delivering finished batches to sink while waiting for room
+    /// @param sink Called as sink(Value&&) for every delivered value, in order
+    template <typename Sink>
+    void submit(batch_type batch, Sink&& sink) {
+        while (!try_submit_or_wait(batch)) {
+            poll(sink);
+        }
+    }
+
+    /// @brief Deliver every batch that is ready, without waiting
+    /// @param sink Called as sink(Value&&) for every delivered value, in order
+    /// @return Number of values delivered
+    ///
+    /// If building a batch threw, the values of earlier batches are delivered
+    /// and the exception is rethrown; the failed batch is dropped.
+    template <typename Sink>
+    size_type poll(Sink&& sink) {
+        std::vector<std::unique_ptr<Slot>> ready;
+        {
+            std::lock_guard lock(mutex_);
+            while (!in_order_.empty() && in_order_.front()->done) {
+                ready.push_back(std::move(in_order_.front()));
+                in_order_.pop_front();
+                if (ready.back()->error) {
+                    break;  // later batches stay queued for the next call
+                }
+            }
+        }
+        if (ready.empty()) {
+            return 0;
+        }
+        progress_.notify_all();
+        return deliver(ready, sink);
+    }
+
+    /// @brief Deliver all batches submitted so far, waiting for workers
+    /// @return Number of values delivered
+    template <typename Sink>
+    size_type drain(Sink&& sink) {
+        size_type delivered = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex_);
+                progress_.wait(lock, [this] { return in_order_.empty() || in_order_.front()->done; });
+                if (in_order_.empty()) {
+                    return delivered;
+                }
+            }
+            delivered += poll(sink);
+        }
+    }
+
+    /// @brief Get number of batches submitted but not yet delivered
+    [[nodiscard]] size_type in_flight() const {
+        std::lock_guard lock(mutex_);
+        return in_order_.size();
+    }
+
+    /// @brief Get the maximum number of batches in flight
+    [[nodiscard]] size_type capacity() const noexcept { return max_in_flight_; }
+
+private:
+    struct Slot {
+        batch_type inputs;
+        std::vector<Value> values;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    void enqueue(batch_type batch, std::unique_lock<std::mutex>& lock) {
+        auto slot = std::make_unique<Slot>();
+        slot->inputs = std::move(batch);
+        queue_.push_back(slot.get());
+        in_order_.push_back(std::move(slot));
+        lock.unlock();
+        work_available_.notify_one();
+    }
+
+    bool try_submit_or_wait(batch_type& batch) {
+        std::unique_lock lock(mutex_);
+        if (in_order_.size() < max_in_flight_) {
+            enqueue(std::move(batch), lock);
+            return true;
+        }
+        // Full: wait until the oldest batch can be delivered
+        progress_.wait(lock, [this] { return in_order_.front()->done; });
+        return false;
+    }
+
+    template <typename Sink>
+    static size_type deliver(std::vector<std::unique_ptr<Slot>>& ready, Sink& sink) {
+        size_type delivered = 0;
+        for (auto& slot : ready) {
+            if (slot->error) {
+                std::rethrow_exception(slot->error);
+            }
+            for (auto& value : slot->values) {
+                sink(std::move(value));
+            }
+            delivered += slot->values.size();
+        }
+        return delivered;
+    }
+
+    void work() {
+        for (;;) {
+            Slot* slot = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                work_available_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                slot = queue_.front();
+                queue_.pop_front();
+            }
+            try {
+                slot->values.reserve(slot->inputs.size());
+                for (const auto& input : slot->inputs) {
+                    slot->values.push_back(build_(input));
+                }
+            } catch (...) {
+                slot->error = std::current_exception();
+            }
+            {
+                std::lock_guard lock(mutex_);
+                slot->done = true;
+            }
+            progress_.notify_all();
+        }
+    }
+
+    build_function build_;
+    size_type max_in_flight_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable progress_;
+    std::deque<Slot*> queue_;                      // waiting for a worker
+    std::deque<std::unique_ptr<Slot>> in_order_;   // submitted, not delivered
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,537 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/lazy_index.hpp
+/// @brief LRU container with secondary indices built on first use
+
+#include <multi_index_lru/container.hpp>
+
+#include <boost/functional/hash.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+template <typename Value, typename Spec, typename Allocator>
+class BoostLazyIndex;
+
+}  // namespace detail
+
+/// @brief Lazy hashed index specifier (keys need not be unique)
+/// @tparam Tag Index tag type
+/// @tparam KeyFromValue Key extractor over the value type (with result_type)
+template <typename Tag, typename KeyFromValue,
+          typename Hash = boost::hash<typename KeyFromValue::result_type>,
+          typename Pred = std::equal_to<typename KeyFromValue::result_type>>
+struct lazy_hashed_non_unique {
+    using tag_type = Tag;
+    using key_from_value_type = KeyFromValue;
+
+    template <typename KeyFromPointer>
+    using index_type = boost::multi_index::hashed_non_unique<KeyFromPointer, Hash, Pred>;
+
+    template <typename Value, typename Allocator>
+    using storage_type = detail::BoostLazyIndex<Value, lazy_hashed_non_unique, Allocator>;
+};
+
+/// @brief Lazy ordered index specifier (keys need not be unique)
+/// @tparam Tag Index tag type
+/// @tparam KeyFromValue Key extractor over the value type (with result_type)
+template <typename Tag, typename KeyFromValue,
+          typename Compare = std::less<typename KeyFromValue::result_type>>
+struct lazy_ordered_non_unique {
+    using tag_type = Tag;
+    using key_from_value_type = KeyFromValue;
+
+    template <typename KeyFromPointer>
+    using index_type = boost::multi_index::ordered_non_unique<KeyFromPointer, Compare>;
+
+    template <typename Value, typename Allocator>
+    using storage_type = detail::BoostLazyIndex<Value, lazy_ordered_non_unique, Allocator>;
+};
+
+/// @brief List of lazy index specifiers
+template <typename... Specs>
+struct lazy_indexed_by {};
+
+namespace detail {
+
+/// Apply a value key extractor through a pointer
+template <typename Value, typename KeyFromValue>
+struct deref_key {
+    using result_type = typename KeyFromValue::result_type;
+
+    result_type operator()(const Value* value) const {
+        return KeyFromValue{}(*value);
+    }
+};
+
+/// @brief Lazy index storage: element pointers indexed by key and by address
+///
+/// Every lazy index storage offers build(elements), insert(element),
+/// erase(element) (called while the element is alive), clear(),
+/// find(key) returning a pointer or nullptr, equal_range(key) and count(key);
+/// ordered storages also offer range(lower, upper). Ranges dereference to
+/// const Value&.
+template <typename Value, typename Spec, typename Allocator>
+class BoostLazyIndex {
+    using container_type = boost::multi_index::multi_index_container<
+        const Value*,
+        boost::multi_index::indexed_by<
+            typename Spec::template index_type<deref_key<Value, typename Spec::key_from_value_type>>,
+            boost::multi_index::hashed_unique<boost::multi_index::identity<const Value*>>>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<const Value*>>;
+    using key_index_type = typename container_type::template nth_index<0>::type;
+
+public:
+    template <typename Range>
+    void build(const Range& elements) {
+        index_.template get<1>().reserve(elements.size());
+        for (const auto& element : elements) {
+            index_.insert(&element);
+        }
+    }
+
+    void insert(const Value* element) { index_.insert(element); }
+
+    void erase(const Value* element) noexcept { index_.template get<1>().erase(element); }
+
+    void clear() noexcept { index_.clear(); }
+
+    [[nodiscard]] const Value* find(const auto& key) const {
+        auto it = keys().find(key);
+        return it == keys().end() ? nullptr : *it;
+    }
+
+    [[nodiscard]] auto equal_range(const auto& key) const {
+        auto [first, last] = keys().equal_range(key);
+        return std::pair{boost::make_indirect_iterator(first), boost::make_indirect_iterator(last)};
+    }
+
+    [[nodiscard]] std::size_t count(const auto& key) const { return keys().count(key); }
+
+    /// Elements with lower <= key < upper (ordered indices only)
+    template <typename Lower, typename Upper>
+        requires requires(const key_index_type& index, const Lower& lower) { index.lower_bound(lower); }
+    [[nodiscard]] auto range(const Lower& lower, const Upper& upper) const {
+        return std::pair{boost::make_indirect_iterator(keys().lower_bound(lower)),
+                         boost::make_indirect_iterator(keys().lower_bound(upper))};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return index_.size(); }
+
+    /// Element pointers count as index links
+    [[nodiscard]] MemoryUsage memory_usage() const noexcept {
+        auto usage = structure_usage(index_);
+        usage.index_links += usage.node_values;
+        usage.node_values = 0;
+        return usage;
+    }
+
+private:
+    const key_index_type& keys() const noexcept { return index_.template get<0>(); }
+
+    container_type index_;
+};
+
+/// Position of Tag among lazy specs, or sizeof...(Specs) if absent
+template <typename Tag, typename... Specs>
+inline constexpr std::size_t lazy_tag_position = [] {
+    constexpr bool matches[] = {std::is_same_v<Tag, typename Specs::tag_type>..., false};
+    std::size_t i = 0;
+    while (i < sizeof...(Specs) && !matches[i]) {
+        ++i;
+    }
+    return i;
+}();
+
+}  // namespace detail
+
+template <typename Value, typename IndexSpecifierList, typename LazyIndexList,
+          typename Allocator = std::allocator<Value>>
+class LazyIndexedContainer;
+
+/// @brief LRU container whose rarely-queried secondary indices are built on demand
+///
+/// Indices in IndexSpecifierList are maintained eagerly, exactly as in
+/// Container. Indices in LazyIndexList cost nothing on insert until they are
+/// first queried (or build_index() is called): the query indexes every
+/// element in one pass, and from then on the index is maintained
+/// incrementally by inserts, evictions, erases and modifications.
+///
+/// A lazy index stores a pointer to each element in its own structure (a
+/// node-based Boost index, or a sorted array with lazy_sorted_array from
+/// sorted_array_index.hpp), so it adds no per-node overhead to the main
+/// container while unbuilt. Lazy indices are non-unique: uniqueness cannot
+/// be enforced by an index that may not exist when an element is inserted.
+///
+/// Lookups through a lazy tag return iterators of the LRU (sequenced)
+/// index, so `cache.find<Tag>(key) != cache.end<Tag>()` works for eager and
+/// lazy tags alike.
+///
+/// @tparam Value The value type stored in the container
+/// @tparam IndexSpecifierList boost::multi_index::indexed_by<...> of eager indices
+/// @tparam LazyIndexList lazy_indexed_by<...> of lazy index specifiers
+/// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+///
+/// Example usage:
+/// @code
+/// using Users = multi_index_lru::LazyIndexedContainer<
+///     User,
+///     boost::multi_index::indexed_by<
+///         boost::multi_index::hashed_unique<
+///             boost::multi_index::tag<IdTag>,
+///             boost::multi_index::member<User, int, &User::id>>>,
+///     multi_index_lru::lazy_indexed_by<
+///         multi_index_lru::lazy_hashed_non_unique<
+///             EmailTag, boost::multi_index::member<User, std::string, &User::email>>>>;
+///
+/// Users users(100'000);
+/// users.emplace(User{1, "a@example.com"});              // id index only
+/// auto it = users.find<EmailTag>(std::string("a@example.com"));  // builds email index
+/// @endcode
+template <typename Value, typename IndexSpecifierList, typename Allocator, typename... LazySpecs>
+class LazyIndexedContainer<Value, IndexSpecifierList, lazy_indexed_by<LazySpecs...>, Allocator> {
+    template <typename Tag>
+    static constexpr std::size_t lazy_position = detail::lazy_tag_position<Tag, LazySpecs...>;
+
+public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using container_type = Container<Value, IndexSpecifierList, Allocator>;
+
+    /// Whether Tag names a lazy index
+    template <typename Tag>
+    static constexpr bool is_lazy_tag = lazy_position<Tag> < sizeof...(LazySpecs);
+
+    /// @brief Construct container with specified capacity
+    /// @param max_size Maximum number of elements before LRU eviction
+    /// @param reserve_buckets Size the eager hashed indices for max_size up front
+    explicit LazyIndexedContainer(size_type max_size, bool reserve_buckets = false)
+        : cache_(max_size, reserve_buckets)
+    {}
+
+    /// @brief Emplace a new element
+    /// @return true if element was newly inserted, false if existing element was refreshed
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        auto& seq_index = cache_.get_sequenced();
+        // The LRU element is evicted if the insert succeeds; unlink it while
+        // it is still alive and restore it if nothing was inserted
+        const Value* victim = any_built() && cache_.size() == cache_.capacity()
+            ? &seq_index.back() : nullptr;
+        if (victim != nullptr) {
+            unlink(victim);
+        }
+        bool inserted = false;
+        try {
+            inserted = cache_.emplace(std::forward<Args>(args)...);
+        } catch (...) {
+            if (victim != nullptr) {
+                link(victim);
+            }
+            throw;
+        }
+        if (!inserted) {
+            if (victim != nullptr) {
+                link(victim);
+            }
+            return false;
+        }
+        link(&seq_index.front());
+        return true;
+    }
+
+    /// @brief Insert a value (copy)
+    bool insert(const Value& value) { return emplace(value); }
+
+    /// @brief Insert a value (move)
+    bool insert(Value&& value) { return emplace(std::move(value)); }
+
+    /// @brief Find element by key, refreshing its LRU position
+    /// @return Iterator to found element, or end<Tag>() if not found
+    ///
+    /// For a lazy tag, builds the index on first use and returns an
+    /// iterator of the LRU index.
+    template <typename Tag>
+    auto find(const auto& key) {
+        if constexpr (is_lazy_tag<Tag>) {
+            auto& seq_index = cache_.get_sequenced();
+            auto it = find_lazy<Tag>(key);
+            if (it != seq_index.end()) {
+                seq_index.relocate(seq_index.begin(), it);
+            }
+            return it;
+        } else {
+            return cache_.template find<Tag>(key);
+        }
+    }
+
+    /// @brief Find element without updating LRU position
+    template <typename Tag>
+    auto find_no_update(const auto& key) {
+        if constexpr (is_lazy_tag<Tag>) {
+            return find_lazy<Tag>(key);
+        } else {
+            return cache_.template find_no_update<Tag>(key);
+        }
+    }
+
+    /// @brief Check if element exists by key, refreshing its LRU position
+    template <typename Tag>
+    bool contains(const auto& key) {
+        return find<Tag>(key) != end<Tag>();
+    }
+
+    /// @brief Check if element exists by key without updating LRU position
+    template <typename Tag>
+    bool contains_no_update(const auto& key) {
+        return find_no_update<Tag>(key) != end<Tag>();
+    }
+
+    /// @brief Find range of elements without updating LRU position
+    /// @return Pair of iterators; for a lazy tag they dereference to const Value&
+    template <typename Tag>
+    auto equal_range_no_update(const auto& key) {
+        if constexpr (is_lazy_tag<Tag>) {
+            return get_lazy_index<Tag>().equal_range(key);
+        } else {
+            return cache_.template equal_range_no_update<Tag>(key);
+        }
+    }
+
+    /// @brief Get elements with lower <= key < upper from an ordered index
+    /// @return Pair of iterators in key order; for a lazy tag they dereference to const Value&
+    template <typename Tag>
+    auto range_no_update(const auto& lower, const auto& upper) {
+        if constexpr (is_lazy_tag<Tag>) {
+            return get_lazy_index<Tag>().range(lower, upper);
+        } else {
+            auto& index = cache_.template get_index<Tag>();
+            return std::pair{index.lower_bound(lower), index.lower_bound(upper)};
+        }
+    }
+
+    /// @brief Count elements with given key
+    template <typename Tag>
+    size_type count(const auto& key) {
+        if constexpr (is_lazy_tag<Tag>) {
+            return get_lazy_index<Tag>().count(key);
+        } else {
+            return cache_.template get_index<Tag>().count(key);
+        }
+    }
+
+    /// @brief Modify element in place and move it to front
+    /// @return true if the element was modified and is still in the container
+    ///
+    /// Built lazy indices are updated for the new keys.
+    template <typename Tag, typename Modifier>
+    bool modify(const auto& key, Modifier&& modifier) {
+        auto it = find_no_update<Tag>(key);
+        if (it == end<Tag>()) {
+            return false;
+        }
+        const Value* element = &*it;
+        unlink(element);
+        auto& seq_index = cache_.get_sequenced();
+        auto seq_it = seq_index.iterator_to(*element);
+        cache_.account_erase(*element);
+        if (!seq_index.modify(seq_it, std::forward<Modifier>(modifier))) {
+            return false;
+        }
+        cache_.account_insert(*element);
+        seq_index.relocate(seq_index.begin(), seq_it);
+        link(element);
+        return true;
+    }
+
+    /// @brief Erase all elements with given key
+    /// @return true if any element was erased
+    template <typename Tag>
+    bool erase(const auto& key) {
+        auto& seq_index = cache_.get_sequenced();
+        if constexpr (is_lazy_tag<Tag>) {
+            auto [first, last] = get_lazy_index<Tag>().equal_range(key);
+            if (first == last) {
+                return false;
+            }
+            std::vector<const Value*> elements;
+            for (auto it = first; it != last; ++it) {
+                elements.push_back(&*it);
+            }
+            for (const Value* element : elements) {
+                unlink(element);
+                cache_.erase(seq_index.iterator_to(*element));
+            }
+            return true;
+        } else {
+            auto& index = cache_.template get_index<Tag>();
+            auto [first, last] = index.equal_range(key);
+            if (first == last) {
+                return false;
+            }
+            while (first != last) {
+                unlink(&*first);
+                first = cache_.erase(first);
+            }
+            return true;
+        }
+    }
+
+    /// @brief Build a lazy index now (e.g. while the owner is idle)
+    ///
+    /// Does nothing if the index is already built.
+    template <typename Tag>
+    void build_index() {
+        static_cast<void>(get_lazy_index<Tag>());
+    }
+
+    /// @brief Build every lazy index
+    void build_indices() {
+        (build_index<typename LazySpecs::tag_type>(), ...);
+    }
+
+    /// @brief Check whether a lazy index has been built
+    template <typename Tag>
+    [[nodiscard]] bool index_built() const noexcept {
+        return std::get<lazy_position<Tag>>(lazy_).built;
+    }
+
+    /// @brief Get the storage of a lazy index, building it on first use
+    ///
+    /// Modify the container only through LazyIndexedContainer, or the index
+    /// goes stale.
+    template <typename Tag>
+    auto& get_lazy_index() {
+        auto& lazy = std::get<lazy_position<Tag>>(lazy_);
+        if (!lazy.built) {
+            lazy.index.build(cache_.get_sequenced());
+            lazy.built = true;
+        }
+        return lazy.index;
+    }
+
+    /// @brief Get end iterator for specified index (the LRU end for lazy tags)
+    template <typename Tag>
+    [[nodiscard]] auto end() {
+        if constexpr (is_lazy_tag<Tag>) {
+            return cache_.get_sequenced().end();
+        } else {
+            return cache_.template end<Tag>();
+        }
+    }
+
+    /// @brief Get number of elements
+    [[nodiscard]] size_type size() const noexcept { return cache_.size(); }
+
+    /// @brief Check if container is empty
+    [[nodiscard]] bool empty() const noexcept { return cache_.empty(); }
+
+    /// @brief Get capacity
+    [[nodiscard]] size_type capacity() const noexcept { return cache_.capacity(); }
+
+    /// @brief Set new capacity, evicting LRU elements if needed
+    void set_capacity(size_type new_capacity) {
+        if (new_capacity == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        auto& seq_index = cache_.get_sequenced();
+        auto it = seq_index.end();
+        for (size_type n = cache_.size(); n > new_capacity; --n) {
+            unlink(&*--it);
+        }
+        cache_.set_capacity(new_capacity);
+    }
+
+    /// @brief Remove all elements; built lazy indices stay built (and empty)
+    void clear() noexcept {
+        cache_.clear();
+        std::apply([](auto&... lazy) { (lazy.index.clear(), ...); }, lazy_);
+    }
+
+    /// @brief Get the bytes used by the container and its built lazy indices
+    ///
+    /// Lazy index storage counts as index links, buckets and allocator
+    /// slack; see Container::memory_usage() for the categories.
+    [[nodiscard]] MemoryUsage memory_usage() const noexcept {
+        auto usage = cache_.memory_usage();
+        std::apply([&usage](const auto&... lazy) {
+            ((lazy.built ? void(usage += lazy.index.memory_usage()) : void()), ...);
+        }, lazy_);
+        return usage;
+    }
+
+    /// @brief Get begin iterator of the LRU index (most recently used first)
+    [[nodiscard]] auto begin() const { return cache_.begin(); }
+
+    /// @brief Get end iterator of the LRU index
+    [[nodiscard]] auto end() const { return cache_.end(); }
+
+    /// @brief Access the eager container (read-only, so lazy indices stay consistent)
+    [[nodiscard]] const container_type& get_cache() const noexcept { return cache_; }
+
+private:
+    template <typename Spec>
+    struct LazyIndex {
+        typename Spec::template storage_type<Value, Allocator> index;
+        bool built = false;
+    };
+
+    template <typename Tag>
+    auto find_lazy(const auto& key) {
+        auto& seq_index = cache_.get_sequenced();
+        const Value* element = get_lazy_index<Tag>().find(key);
+        return element == nullptr ? seq_index.end() : seq_index.iterator_to(*element);
+    }
+
+    [[nodiscard]] bool any_built() const noexcept {
+        return std::apply([](const auto&... lazy) { return (lazy.built || ...); }, lazy_);
+    }
+
+    void link(const Value* element) {
+        std::apply([element](auto&... lazy) {
+            ((lazy.built ? lazy.index.insert(element) : void()), ...);
+        }, lazy_);
+    }
+
+    /// Remove a (still alive) element from built lazy indices
+    void unlink(const Value* element) {
+        std::apply([element](auto&... lazy) {
+            ((lazy.built ? lazy.index.erase(element) : void()), ...);
+        }, lazy_);
+    }
+
+    container_type cache_;
+    std::tuple<LazyIndex<LazySpecs>...> lazy_;
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,273 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/memory_budget.hpp
+/// @brief One byte budget shared by several caches, evicting the coldest tail first
+
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/expirable_container.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+/// Registered caches of MemoryBudget and PressureMonitor, each kept by a
+/// Registration handle; Entry starts with a std::uint64_t id
+template <typename Entry>
+class Registry {
+public:
+    /// @brief Handle that keeps a cache registered; unregisters on destruction
+    class Registration {
+    public:
+        Registration() = default;
+
+        Registration(Registration&& other) noexcept
+            : registry_(std::exchange(other.registry_, nullptr)), id_(other.id_)
+        {}
+
+        Registration& operator=(Registration&& other) noexcept {
+            if (this != &other) {
+                reset();
+                registry_ = std::exchange(other.registry_, nullptr);
+                id_ = other.id_;
+            }
+            return *this;
+        }
+
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+
+        ~Registration() { reset(); }
+
+        /// @brief Unregister the cache now
+        void reset() noexcept {
+            if (registry_ != nullptr) {
+                registry_->remove(id_);
+                registry_ = nullptr;
+            }
+        }
+
+        /// @brief Check whether a cache is registered through this handle
+        explicit operator bool() const noexcept { return registry_ != nullptr; }
+
+    private:
+        friend class Registry;
+
+        Registration(Registry* registry, std::uint64_t id) : registry_(registry), id_(id) {}
+
+        Registry* registry_ = nullptr;
+        std::uint64_t id_ = 0;
+    };
+
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /// Add Entry{id, args...}
+    template <typename... Args>
+    Registration add(Args&&... args) {
+        const auto id = next_id_++;
+        entries_.push_back(Entry{id, std::forward<Args>(args)...});
+        return Registration(this, id);
+    }
+
+    std::vector<Entry>& entries() noexcept { return entries_; }
+    const std::vector<Entry>& entries() const noexcept { return entries_; }
+
+private:
+    void remove(std::uint64_t id) noexcept {
+        std::erase_if(entries_, [id](const Entry& entry) { return entry.id == id; });
+    }
+
+    std::vector<Entry> entries_;
+    std::uint64_t next_id_ = 0;
+};
+
+}  // namespace detail
+
+/// @brief Byte budget enforced across several caches
+///
+/// Caches register with the budget; enforce() then evicts LRU elements
+/// until the sum of their memory_usage().total() fits the budget. Each
+/// eviction is taken from the cache whose LRU element was accessed longest
+/// ago, so memory flows from caches holding cold data to caches whose data
+/// is still being used: across caches, the element given up is always the
+/// one least likely to be hit again, which is what a single LRU over all of
+/// them would have evicted.
+///
+/// Not thread-safe: like Container, use the budget and its caches from one
+/// thread (or under one lock). The budget must outlive its registrations.
+///
+/// Example usage:
+/// @code
+/// multi_index_lru::MemoryBudget budget(512 << 20);  // 512 MiB for all caches
+/// auto users_reg = budget.add(users);                // ExpirableContainer
+/// auto quotes_reg = budget.add(quotes, [](const Quote& q) { return q.received_at; });
+///
+/// users.insert(user);
+/// budget.enforce();  // after a batch of inserts
+/// @endcode
+class MemoryBudget {
+public:
+    using clock_type = std::chrono::steady_clock;
+    using time_point_type = clock_type::time_point;
+
+private:
+    struct Entry;
+
+public:
+    /// @brief Handle that keeps a cache registered; unregisters on destruction
+    using Registration = typename detail::Registry<Entry>::Registration;
+
+    /// @brief Create a budget
+    /// @param budget_bytes Maximum total bytes of all registered caches (must be positive)
+    explicit MemoryBudget(std::size_t budget_bytes) : budget_(budget_bytes) {
+        if (budget_bytes == 0) {
+            throw std::invalid_argument("Memory budget must be greater than 0");
+        }
+    }
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /// @brief Register an ExpirableContainer, ranked by its elements' access times
+    template <typename Value, typename IndexSpecifierList, typename Allocator, typename TimestampStorage>
+    [[nodiscard]] Registration add(
+        ExpirableContainer<Value, IndexSpecifierList, Allocator, TimestampStorage>& cache) {
+        return add_entry(
+            [&cache] { return cache.memory_usage().total(); },
+            [&cache] { return cache.lru_last_accessed(); },
+            [&cache] { return cache.evict_lru(); });
+    }
+
+    /// @brief Register a Container, ranked by a time read from its values
+    /// @param cache Container to register
+    /// @param access_time Called as access_time(const Value&), returns a time_point_type
+    ///
+    /// Container keeps no access times; access_time supplies one per value
+    /// (e.g. when it was received or last refreshed). It is only called on
+    /// the LRU element.
+    template <typename Value, typename IndexSpecifierList, typename Allocator, typename AccessTime>
+        requires std::is_invocable_r_v<time_point_type, AccessTime&, const Value&>
+    [[nodiscard]] Registration add(Container<Value, IndexSpecifierList, Allocator>& cache,
+                                   AccessTime access_time) {
+        return add_entry(
+            [&cache] { return cache.memory_usage().total(); },
+            [&cache, access_time]() mutable -> std::optional<time_point_type> {
+                if (cache.empty()) {
+                    return std::nullopt;
+                }
+                return access_time(cache.get_sequenced().back());
+            },
+            [&cache] { return cache.evict_lru(); });
+    }
+
+    /// @brief Register any cache through callbacks
+    /// @param bytes Returns the cache's current size in bytes
+    /// @param lru_access_time Returns the LRU element's last access time, or std::nullopt if empty
+    /// @param evict_lru Evicts the LRU element, returns false if there was none
+    [[nodiscard]] Registration add(std::function<std::size_t()> bytes,
+                                   std::function<std::optional<time_point_type>()> lru_access_time,
+                                   std::function<bool()> evict_lru) {
+        return add_entry(std::move(bytes), std::move(lru_access_time), std::move(evict_lru));
+    }
+
+    /// @brief Evict from the caches with the coldest LRU elements until the budget is met
+    /// @param max_evictions Stop after this many evictions, bounding the call's duration
+    /// @return Number of elements evicted
+    ///
+    /// Stops early if every cache is empty (fixed overhead such as bucket
+    /// arrays may exceed a small budget on its own). Costs one
+    /// memory_usage() and LRU lookup per cache per eviction.
+    std::size_t enforce(std::size_t max_evictions = std::numeric_limits<std::size_t>::max()) {
+        std::size_t evicted = 0;
+        auto total = usage();
+        while (total > budget_ && evicted < max_evictions) {
+            Entry* coldest = nullptr;
+            time_point_type coldest_time{};
+            for (auto& entry : registry_.entries()) {
+                const auto tail = entry.lru_access_time();
+                if (tail && (coldest == nullptr || *tail < coldest_time)) {
+                    coldest = &entry;
+                    coldest_time = *tail;
+                }
+            }
+            if (coldest == nullptr) {
+                break;
+            }
+            const auto before = coldest->bytes();
+            if (!coldest->evict_lru()) {
+                break;
+            }
+            total = total - before + coldest->bytes();
+            ++evicted;
+        }
+        return evicted;
+    }
+
+    /// @brief Get the total bytes of all registered caches
+    [[nodiscard]] std::size_t usage() const {
+        std::size_t total = 0;
+        for (const auto& entry : registry_.entries()) {
+            total += entry.bytes();
+        }
+        return total;
+    }
+
+    /// @brief Get the budget in bytes
+    [[nodiscard]] std::size_t budget() const noexcept { return budget_; }
+
+    /// @brief Change the budget; takes effect on the next enforce()
+    void set_budget(std::size_t budget_bytes) {
+        if (budget_bytes == 0) {
+            throw std::invalid_argument("Memory budget must be greater than 0");
+        }
+        budget_ = budget_bytes;
+    }
+
+    /// @brief Get the number of registered caches
+    [[nodiscard]] std::size_t cache_count() const noexcept { return registry_.entries().size(); }
+
+private:
+    struct Entry {
+        std::uint64_t id;
+        std::function<std::size_t()> bytes;
+        std::function<std::optional<time_point_type>()> lru_access_time;
+        std::function<bool()> evict_lru;
+    };
+
+    Registration add_entry(std::function<std::size_t()> bytes,
+                           std::function<std::optional<time_point_type>()> lru_access_time,
+                           std::function<bool()> evict_lru) {
+        return registry_.add(std::move(bytes), std::move(lru_access_time), std::move(evict_lru));
+    }
+
+    detail::Registry<Entry> registry_;
+    std::size_t budget_;
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,135 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/memory_usage.hpp
+/// @brief Memory accounting for caches: byte breakdown and heap_bytes() customization point
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief Bytes used by a cache, by category
+///
+/// node_values + index_links is what the element nodes take; buckets are
+/// the hashed indices' bucket arrays; payload is heap memory owned by the
+/// values (strings, vectors, ...) as reported by heap_bytes(); allocator
+/// slack estimates what malloc adds on top of each node and bucket array.
+struct MemoryUsage {
+    /// sizeof(Value) for every element
+    std::size_t node_values = 0;
+    /// Index links of every node, plus the container's header node
+    std::size_t index_links = 0;
+    /// Bucket arrays of hashed indices
+    std::size_t buckets = 0;
+    /// Heap bytes owned by the values (0 unless heap_bytes() is provided)
+    std::size_t payload = 0;
+    /// Estimated allocator overhead of nodes and bucket arrays
+    std::size_t allocator_slack = 0;
+
+    /// @brief Get the sum of all categories
+    [[nodiscard]] std::size_t total() const noexcept {
+        return node_values + index_links + buckets + payload + allocator_slack;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+        node_values += other.node_values;
+        index_links += other.index_links;
+        buckets += other.buckets;
+        payload += other.payload;
+        allocator_slack += other.allocator_slack;
+        return *this;
+    }
+
+    friend MemoryUsage operator+(MemoryUsage lhs, const MemoryUsage& rhs) noexcept {
+        lhs += rhs;
+        return lhs;
+    }
+
+    friend bool operator==(const MemoryUsage&, const MemoryUsage&) = default;
+};
+
+/// @brief Heap bytes owned by a string (0 while it fits the small buffer)
+template <typename CharT, typename Traits, typename Alloc>
+std::size_t heap_bytes(const std::basic_string<CharT, Traits, Alloc>& str) noexcept;
+
+/// @brief Heap bytes owned by a vector and, if measurable, its elements
+template <typename T, typename Alloc>
+std::size_t heap_bytes(const std::vector<T, Alloc>& vec);
+
+namespace detail {
+
+/// Whether heap_bytes(value) is available, through the overloads above or ADL
+template <typename T>
+concept has_heap_bytes = requires(const T& value) {
+    { heap_bytes(value) } -> std::convertible_to<std::size_t>;
+};
+
+/// heap_bytes(value), or 0 for types without it
+template <typename T>
+std::size_t payload_bytes(const T& value) {
+    if constexpr (has_heap_bytes<T>) {
+        return heap_bytes(value);
+    } else {
+        return 0;
+    }
+}
+
+/// Sum of payload_bytes() over the elements of a tuple (e.g. extracted keys)
+template <typename Tuple>
+std::size_t tuple_payload_bytes(const Tuple& tuple) {
+    return std::apply([](const auto&... elements) {
+        return (std::size_t{0} + ... + payload_bytes(elements));
+    }, tuple);
+}
+
+/// Bytes a malloc with 16-byte granularity, an 8-byte chunk header and a
+/// 32-byte minimum chunk (glibc) adds to an n-byte allocation
+constexpr std::size_t malloc_slack(std::size_t n) noexcept {
+    const auto chunk = std::max<std::size_t>(32, (n + 8 + 15) & ~std::size_t{15});
+    return chunk - n;
+}
+
+}  // namespace detail
+
+template <typename CharT, typename Traits, typename Alloc>
+std::size_t heap_bytes(const std::basic_string<CharT, Traits, Alloc>& str) noexcept {
+    const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+    const auto* self = reinterpret_cast<const unsigned char*>(&str);
+    const std::less<const unsigned char*> less;
+    if (!less(data, self) && less(data, self + sizeof(str))) {
+        return 0;
+    }
+    return (str.capacity() + 1) * sizeof(CharT);
+}
+
+template <typename T, typename Alloc>
+std::size_t heap_bytes(const std::vector<T, Alloc>& vec) {
+    std::size_t bytes = vec.capacity() * sizeof(T);
+    if constexpr (detail::has_heap_bytes<T>) {
+        for (const auto& element : vec) {
+            bytes += heap_bytes(element);
+        }
+    }
+    return bytes;
+}
+
+}  // namespace multi_index_lru
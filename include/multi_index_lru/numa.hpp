@@ -0,0 +1,260 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/numa.hpp
+/// @brief NUMA node queries and a node-bound allocator for container shards
+///
+/// Memory is bound with libnuma when MULTI_INDEX_LRU_HAS_LIBNUMA is defined
+/// (the CMake option MULTI_INDEX_LRU_USE_LIBNUMA does this) and libnuma
+/// reports NUMA support at runtime. Otherwise every query reports a single
+/// node and allocations come from the global heap.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+#include <numa.h>
+#include <sched.h>
+#endif
+
+namespace multi_index_lru {
+
+namespace numa {
+
+/// @brief Check whether allocations can be bound to NUMA nodes
+[[nodiscard]] inline bool available() noexcept {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+    static const bool result = numa_available() >= 0;
+    return result;
+#else
+    return false;
+#endif
+}
+
+/// @brief Get number of configured NUMA nodes (1 without NUMA support)
+[[nodiscard]] inline int node_count() noexcept {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+    if (available()) {
+        return std::max(numa_num_configured_nodes(), 1);
+    }
+#endif
+    return 1;
+}
+
+/// @brief Get the node of the CPU the calling thread runs on (0 without NUMA support)
+[[nodiscard]] inline int current_node() noexcept {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+    if (available()) {
+        // numa_node_of_cpu() scans node masks; look it up once per CPU
+        static const std::vector<int> node_of_cpu = [] {
+            std::vector<int> table(static_cast<std::size_t>(std::max(numa_num_configured_cpus(), 1)), 0);
+            for (std::size_t cpu = 0; cpu < table.size(); ++cpu) {
+                table[cpu] = std::max(numa_node_of_cpu(static_cast<int>(cpu)), 0);
+            }
+            return table;
+        }();
+        const int cpu = sched_getcpu();
+        return cpu < 0 || static_cast<std::size_t>(cpu) >= node_of_cpu.size()
+            ? 0 : node_of_cpu[static_cast<std::size_t>(cpu)];
+    }
+#endif
+    return 0;
+}
+
+/// @brief Node a shard is placed on when spreading shards over all nodes
+[[nodiscard]] inline int node_for_shard(std::size_t shard_index) noexcept {
+    return static_cast<int>(shard_index % static_cast<std::size_t>(node_count()));
+}
+
+/// @brief Restrict the calling thread to the CPUs of a node
+/// @return false if NUMA is not available or the call failed
+inline bool run_on_node(int node) noexcept {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+    if (available()) {
+        return numa_run_on_node(node) == 0;
+    }
+#endif
+    static_cast<void>(node);
+    return false;
+}
+
+}  // namespace numa
+
+/// @brief Pool of memory bound to one NUMA node
+///
+/// Small blocks (container nodes) are carved out of node-bound chunks and
+/// recycled through per-size free lists; large blocks (bucket arrays) are
+/// bound individually. An arena is not thread-safe: give each independently
+/// locked container (e.g. each shard) its own arena.
+class NumaArena {
+public:
+    /// @brief Create an arena
+    /// @param node NUMA node to bind memory to; negative for no binding
+    /// @param chunk_size Bytes requested from the system at a time
+    explicit NumaArena(int node = -1, std::size_t chunk_size = std::size_t{1} << 20U)
+        : node_(node), chunk_size_(chunk_size), free_lists_(kMaxSmall / kGranule + 1, nullptr)
+    {}
+
+    NumaArena(const NumaArena&) = delete;
+    NumaArena& operator=(const NumaArena&) = delete;
+
+    ~NumaArena() {
+        for (const auto& chunk : chunks_) {
+            release(chunk.data, chunk.size, kGranule);
+        }
+    }
+
+    /// @brief Allocate a block of given size and alignment
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        if (bytes > kMaxSmall || alignment > kGranule) {
+            return acquire(bytes, alignment);
+        }
+        const auto size_class = (bytes + kGranule - 1) / kGranule;
+        auto& head = free_lists_[size_class];
+        if (head != nullptr) {
+            void* block = head;
+            head = *static_cast<void**>(block);
+            return block;
+        }
+        const auto size = size_class * kGranule;
+        if (static_cast<std::size_t>(end_ - cursor_) < size) {
+            cursor_ = static_cast<char*>(acquire(chunk_size_, kGranule));
+            end_ = cursor_ + chunk_size_;
+            chunks_.push_back(Chunk{cursor_, chunk_size_});
+        }
+        void* block = cursor_;
+        cursor_ += size;
+        return block;
+    }
+
+    /// @brief Return a block obtained from allocate() with the same size and alignment
+    void deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+        if (bytes > kMaxSmall || alignment > kGranule) {
+            release(block, bytes, alignment);
+            return;
+        }
+        auto& head = free_lists_[(bytes + kGranule - 1) / kGranule];
+        *static_cast<void**>(block) = head;
+        head = block;
+    }
+
+    /// @brief Get the node this arena binds memory to (negative if unbound)
+    [[nodiscard]] int node() const noexcept { return node_; }
+
+    /// @brief Get bytes held in chunks, including free blocks
+    [[nodiscard]] std::size_t reserved_bytes() const noexcept {
+        return chunks_.size() * chunk_size_;
+    }
+
+private:
+    static constexpr std::size_t kGranule = 16;
+    static constexpr std::size_t kMaxSmall = 512;
+
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    [[nodiscard]] bool binds() const noexcept { return node_ >= 0 && numa::available(); }
+
+    /// Node-bound blocks are page-aligned; others honour alignment through
+    /// the aligned operator new when it exceeds the default new alignment
+    void* acquire(std::size_t bytes, std::size_t alignment) {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+        if (binds()) {
+            void* block = numa_alloc_onnode(bytes, node_);
+            if (block == nullptr) {
+                throw std::bad_alloc();
+            }
+            return block;
+        }
+#endif
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t{alignment});
+        }
+        return ::operator new(bytes);
+    }
+
+    void release(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+#if defined(MULTI_INDEX_LRU_HAS_LIBNUMA)
+        if (binds()) {
+            numa_free(block, bytes);
+            return;
+        }
+#endif
+        static_cast<void>(bytes);
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(block, std::align_val_t{alignment});
+            return;
+        }
+        ::operator delete(block);
+    }
+
+    int node_;
+    std::size_t chunk_size_;
+    std::vector<void*> free_lists_;
+    std::vector<Chunk> chunks_;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+};
+
+/// @brief Allocator drawing from a shared NumaArena
+///
+/// Copies and rebinds share the arena, so a Container's nodes and bucket
+/// arrays all land on the arena's node. Usable as the Allocator parameter of
+/// Container, ShardedContainer and ReplicatedContainer.
+///
+/// @tparam T Allocated type
+template <typename T>
+class NumaAllocator {
+public:
+    using value_type = T;
+
+    /// @brief Allocator with its own arena that does not bind memory
+    NumaAllocator() : arena_(std::make_shared<NumaArena>()) {}
+
+    /// @brief Allocator with its own arena bound to given node
+    explicit NumaAllocator(int node) : arena_(std::make_shared<NumaArena>(node)) {}
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        arena_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    /// @brief Get the node memory is bound to (negative if unbound)
+    [[nodiscard]] int node() const noexcept { return arena_->node(); }
+
+    [[nodiscard]] const std::shared_ptr<NumaArena>& arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const NumaAllocator<U>& other) const noexcept {
+        return arena_ == other.arena();
+    }
+
+private:
+    std::shared_ptr<NumaArena> arena_;
+};
+
+}  // namespace multi_index_lru
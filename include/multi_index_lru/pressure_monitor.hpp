@@ -0,0 +1,285 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/pressure_monitor.hpp
+/// @brief Shrink cache capacities under cgroup v2 memory pressure, restore them afterwards
+
+#include <multi_index_lru/memory_budget.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief One sample of a cgroup v2 memory controller
+struct PressureReading {
+    /// memory.current: bytes charged to the cgroup
+    std::optional<std::uint64_t> current_bytes;
+    /// memory.max: the cgroup's hard limit (std::nullopt if "max" or unreadable)
+    std::optional<std::uint64_t> limit_bytes;
+    /// memory.pressure: "some avg10", the share (0-100) of the last 10 s that
+    /// some task stalled on memory
+    std::optional<double> some_avg10;
+
+    /// @brief Get current_bytes / limit_bytes, if both are known
+    [[nodiscard]] std::optional<double> usage_fraction() const noexcept {
+        if (!current_bytes || !limit_bytes || *limit_bytes == 0) {
+            return std::nullopt;
+        }
+        return static_cast<double>(*current_bytes) / static_cast<double>(*limit_bytes);
+    }
+};
+
+/// @brief Options for PressureMonitor
+///
+/// Pressure starts when usage reaches high_usage or PSI reaches
+/// high_pressure, and ends when both are below their low thresholds; in
+/// between, the scale is left alone.
+struct PressureMonitorOptions {
+    /// cgroup v2 directory holding memory.current, memory.max and memory.pressure
+    std::filesystem::path cgroup_path = "/sys/fs/cgroup";
+    /// memory.current / memory.max at which caches start shrinking
+    double high_usage = 0.90;
+    /// memory.current / memory.max below which caches grow back
+    double low_usage = 0.80;
+    /// "some avg10" at which caches start shrinking
+    double high_pressure = 10.0;
+    /// "some avg10" below which caches grow back
+    double low_pressure = 1.0;
+    /// Scale multiplier applied per poll under pressure
+    double shrink_factor = 0.75;
+    /// Scale added per poll once pressure subsides
+    double grow_step = 0.10;
+    /// Lowest scale caches are shrunk to
+    double min_scale = 0.10;
+    /// Elements evicted per poll across all caches, bounding the time poll() takes
+    std::size_t max_evictions_per_poll = 4096;
+};
+
+/// @brief Lower registered caches' capacities under memory pressure
+///
+/// Every poll() reads the cgroup's memory.current, memory.max and
+/// memory.pressure. Under pressure the scale drops by shrink_factor (down
+/// to min_scale); once pressure subsides it grows by grow_step back to 1.
+/// Each registered cache is steered towards scale times the capacity it
+/// had when registered, evicting at most max_evictions_per_poll elements per
+/// poll in total: a cache far above its target shrinks over several polls
+/// instead of stalling one. A spike that would otherwise end in an OOM kill
+/// costs hit rate instead.
+///
+/// Missing or unreadable files are treated as no signal, so the monitor is
+/// inert outside a cgroup v2 container; tests point cgroup_path at a
+/// directory of fake files.
+///
+/// Not thread-safe: call poll() (e.g. from a periodic timer) where the
+/// registered caches may be used, or under their lock. ShardedContainer is
+/// thread-safe itself. The monitor must outlive its registrations.
+///
+/// Example usage:
+/// @code
+/// multi_index_lru::PressureMonitor monitor;
+/// auto users_reg = monitor.add(users);
+/// auto budget_reg = monitor.add(budget);  // scales a MemoryBudget instead
+///
+/// // Every second:
+/// monitor.poll();
+/// @endcode
+class PressureMonitor {
+    struct Entry;
+
+public:
+    /// @brief Handle that keeps a cache registered; unregisters on destruction
+    ///
+    /// Unregistering leaves the cache at its current capacity.
+    using Registration = typename detail::Registry<Entry>::Registration;
+
+    /// @brief Create a monitor
+    /// @param options cgroup path, thresholds, step sizes and eviction bound
+    explicit PressureMonitor(PressureMonitorOptions options = {}) : options_(std::move(options)) {
+        if (!(options_.low_usage <= options_.high_usage) || !(options_.low_pressure <= options_.high_pressure)) {
+            throw std::invalid_argument("Pressure thresholds must satisfy low <= high");
+        }
+        if (!(options_.shrink_factor > 0.0 && options_.shrink_factor < 1.0)) {
+            throw std::invalid_argument("Shrink factor must be in (0, 1)");
+        }
+        if (!(options_.min_scale > 0.0 && options_.min_scale <= 1.0)) {
+            throw std::invalid_argument("Minimum scale must be in (0, 1]");
+        }
+        if (!(options_.grow_step > 0.0)) {
+            throw std::invalid_argument("Grow step must be positive");
+        }
+        if (options_.max_evictions_per_poll == 0) {
+            throw std::invalid_argument("Evictions per poll must be greater than 0");
+        }
+    }
+
+    PressureMonitor(const PressureMonitor&) = delete;
+    PressureMonitor& operator=(const PressureMonitor&) = delete;
+
+    /// @brief Register a cache with capacity(), set_capacity() and size()
+    ///
+    /// Works with Container, ExpirableContainer, LazyIndexedContainer and
+    /// ShardedContainer. The capacity at registration is the one restored.
+    template <typename Cache>
+        requires requires(Cache& cache, std::size_t n) {
+            { cache.capacity() } -> std::convertible_to<std::size_t>;
+            { cache.size() } -> std::convertible_to<std::size_t>;
+            cache.set_capacity(n);
+        }
+    [[nodiscard]] Registration add(Cache& cache) {
+        const std::size_t base = cache.capacity();
+        return add_entry(base, [&cache](std::size_t target, std::size_t max_evictions) {
+            const std::size_t size = cache.size();
+            const std::size_t capacity = cache.capacity();
+            if (target >= capacity) {
+                cache.set_capacity(target);
+                return std::size_t{0};
+            }
+            // Never evict more than max_evictions in one step
+            const std::size_t floor = size > max_evictions ? size - max_evictions : 0;
+            cache.set_capacity(std::max(target, floor));
+            const std::size_t after = cache.size();
+            return size > after ? size - after : std::size_t{0};
+        });
+    }
+
+    /// @brief Register a MemoryBudget, scaling its byte budget instead of a capacity
+    [[nodiscard]] Registration add(MemoryBudget& budget) {
+        const std::size_t base = budget.budget();
+        return add_entry(base, [&budget](std::size_t target, std::size_t max_evictions) {
+            budget.set_budget(target);
+            return budget.enforce(max_evictions);
+        });
+    }
+
+    /// @brief Read the cgroup, adjust the scale and steer every cache towards it
+    /// @return The reading the decision was based on
+    PressureReading poll() {
+        const auto reading = read();
+        if (under_pressure(reading)) {
+            scale_ = std::max(options_.min_scale, scale_ * options_.shrink_factor);
+        } else if (relieved(reading)) {
+            scale_ = std::min(1.0, scale_ + options_.grow_step);
+        }
+        apply();
+        return reading;
+    }
+
+    /// @brief Steer every cache towards the current scale without reading the cgroup
+    /// @return Number of elements evicted
+    ///
+    /// Lets a poll that hit max_evictions_per_poll be continued sooner.
+    std::size_t apply() {
+        std::size_t remaining = options_.max_evictions_per_poll;
+        std::size_t evicted = 0;
+        for (auto& entry : registry_.entries()) {
+            const auto target = std::max<std::size_t>(
+                1, static_cast<std::size_t>(std::llround(static_cast<double>(entry.base) * scale_)));
+            const auto done = entry.steer(target, remaining);
+            evicted += done;
+            remaining -= std::min(done, remaining);
+        }
+        return evicted;
+    }
+
+    /// @brief Sample memory.current, memory.max and memory.pressure
+    [[nodiscard]] PressureReading read() const {
+        PressureReading reading;
+        reading.current_bytes = read_bytes(options_.cgroup_path / "memory.current");
+        reading.limit_bytes = read_bytes(options_.cgroup_path / "memory.max");
+
+        std::ifstream pressure(options_.cgroup_path / "memory.pressure");
+        std::string line;
+        while (std::getline(pressure, line)) {
+            std::istringstream fields(line);
+            std::string kind;
+            fields >> kind;
+            if (kind != "some") {
+                continue;
+            }
+            std::string field;
+            while (fields >> field) {
+                if (field.rfind("avg10=", 0) == 0) {
+                    try {
+                        reading.some_avg10 = std::stod(field.substr(6));
+                    } catch (const std::exception&) {
+                    }
+                }
+            }
+        }
+        return reading;
+    }
+
+    /// @brief Get the fraction of their registered capacity caches are steered to
+    [[nodiscard]] double scale() const noexcept { return scale_; }
+
+    /// @brief Get the options
+    [[nodiscard]] const PressureMonitorOptions& options() const noexcept { return options_; }
+
+    /// @brief Get the number of registered caches
+    [[nodiscard]] std::size_t cache_count() const noexcept { return registry_.entries().size(); }
+
+private:
+    struct Entry {
+        std::uint64_t id;
+        std::size_t base;
+        /// steer(target, max_evictions): move towards target, return evictions
+        std::function<std::size_t(std::size_t, std::size_t)> steer;
+    };
+
+    static std::optional<std::uint64_t> read_bytes(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        std::uint64_t bytes = 0;
+        if (file >> bytes) {
+            return bytes;
+        }
+        return std::nullopt;  // missing, or "max"
+    }
+
+    bool under_pressure(const PressureReading& reading) const noexcept {
+        const auto usage = reading.usage_fraction();
+        return (usage && *usage >= options_.high_usage) ||
+               (reading.some_avg10 && *reading.some_avg10 >= options_.high_pressure);
+    }
+
+    bool relieved(const PressureReading& reading) const noexcept {
+        const auto usage = reading.usage_fraction();
+        return (!usage || *usage < options_.low_usage) &&
+               (!reading.some_avg10 || *reading.some_avg10 < options_.low_pressure);
+    }
+
+    Registration add_entry(std::size_t base, std::function<std::size_t(std::size_t, std::size_t)> steer) {
+        return registry_.add(base, std::move(steer));
+    }
+
+    PressureMonitorOptions options_;
+    detail::Registry<Entry> registry_;
+    double scale_ = 1.0;
+};
+
+}  // namespace multi_index_lru
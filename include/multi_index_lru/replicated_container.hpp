@@ -0,0 +1,232 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/replicated_container.hpp
+/// @brief Read-mostly container replicated once per NUMA node
+
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/numa.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief Container kept as identical replicas so readers stay node-local
+///
+/// Every write is applied to all replicas in the same order, so replicas hold
+/// the same elements in the same LRU order. Reads go to the replica of the
+/// caller's NUMA node under a shared lock and never cross the interconnect
+/// when each replica's allocator binds memory to its node (see
+/// NumaAllocator). Writes cost one operation per replica.
+///
+/// Reads do not refresh LRU positions (that would make replicas diverge), so
+/// only *_no_update lookups are offered and eviction follows insertion order.
+/// Meant for read-mostly data such as reference data or configuration.
+///
+/// @tparam Value The value type stored in the container
+/// @tparam IndexSpecifierList boost::multi_index::indexed_by<...> specifying indices
+/// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+///
+/// Example usage:
+/// @code
+/// using Instruments = multi_index_lru::ReplicatedContainer<
+///     Instrument, Indices, multi_index_lru::NumaAllocator<Instrument>>;
+///
+/// Instruments instruments(100'000, multi_index_lru::numa::node_count(),
+///     [](std::size_t node) { return multi_index_lru::NumaAllocator<Instrument>(int(node)); });
+/// instruments.insert(Instrument{"AAPL", 1});
+/// auto hit = instruments.find_no_update<SymbolTag>(std::string("AAPL"));  // local replica
+/// @endcode
+template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>>
+class ReplicatedContainer {
+public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using replica_type = Container<Value, IndexSpecifierList, Allocator>;
+
+    /// @brief Construct with one replica per NUMA node
+    /// @param max_size Capacity of every replica
+    explicit ReplicatedContainer(size_type max_size)
+        : ReplicatedContainer(max_size, static_cast<size_type>(numa::node_count()))
+    {}
+
+    /// @brief Construct with given number of replicas using default allocators
+    ReplicatedContainer(size_type max_size, size_type replica_count)
+        : ReplicatedContainer(max_size, replica_count, [](size_type) { return Allocator(); })
+    {}
+
+    /// @brief Construct with given number of replicas
+    /// @param max_size Capacity of every replica
+    /// @param replica_count Number of replicas; replica i serves node i % replica_count
+    /// @param make_allocator Called as make_allocator(replica_index) for every replica
+    template <typename AllocatorFactory>
+        requires std::is_invocable_r_v<Allocator, AllocatorFactory&, size_type>
+    ReplicatedContainer(size_type max_size, size_type replica_count, AllocatorFactory make_allocator) {
+        if (max_size == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        if (replica_count == 0) {
+            throw std::invalid_argument("Replica count must be greater than 0");
+        }
+        replicas_.reserve(replica_count);
+        for (size_type i = 0; i < replica_count; ++i) {
+            replicas_.push_back(std::make_unique<Replica>(max_size, make_allocator(i)));
+        }
+    }
+
+    /// @brief Emplace a new element into every replica
+    /// @return true if element was newly inserted, false if existing element was refreshed
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        return insert(Value(std::forward<Args>(args)...));
+    }
+
+    /// @brief Insert a value into every replica
+    bool insert(const Value& value) {
+        return for_each_replica([&value](replica_type& cache) { return cache.insert(value); });
+    }
+
+    /// @brief Erase element by key from every replica
+    template <typename Tag>
+    bool erase(const auto& key) {
+        return for_each_replica([&key](replica_type& cache) {
+            return cache.template erase<Tag>(key);
+        });
+    }
+
+    /// @brief Remove all elements from every replica
+    void clear() {
+        for_each_replica([](replica_type& cache) {
+            cache.clear();
+            return true;
+        });
+    }
+
+    /// @brief Set capacity of every replica
+    void set_capacity(size_type new_capacity) {
+        if (new_capacity == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        for_each_replica([new_capacity](replica_type& cache) {
+            cache.set_capacity(new_capacity);
+            return true;
+        });
+    }
+
+    /// @brief Run a function on the caller's local replica under a shared lock
+    /// @param reader Called as reader(const replica_type&)
+    template <typename Reader>
+    decltype(auto) read(Reader&& reader) const {
+        const auto& replica = *replicas_[local_replica()];
+        std::shared_lock lock(replica.mutex);
+        return reader(static_cast<const replica_type&>(replica.cache));
+    }
+
+    /// @brief Find element in the local replica and return a copy
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @return Copy of the element, or std::nullopt if not found
+    template <typename Tag>
+    std::optional<Value> find_no_update(const auto& key) const {
+        return read([&key](const replica_type& cache) -> std::optional<Value> {
+            auto it = cache.template find_no_update<Tag>(key);
+            if (it == cache.template end<Tag>()) {
+                return std::nullopt;
+            }
+            return *it;
+        });
+    }
+
+    /// @brief Run a visitor on the element with given key in the local replica
+    /// @return true if the element was found
+    template <typename Tag, typename Visitor>
+    bool visit_no_update(const auto& key, Visitor&& visitor) const {
+        return read([&](const replica_type& cache) {
+            auto it = cache.template find_no_update<Tag>(key);
+            if (it == cache.template end<Tag>()) {
+                return false;
+            }
+            visitor(static_cast<const Value&>(*it));
+            return true;
+        });
+    }
+
+    /// @brief Check if element exists in the local replica
+    template <typename Tag>
+    bool contains_no_update(const auto& key) const {
+        return read([&key](const replica_type& cache) {
+            return cache.template contains_no_update<Tag>(key);
+        });
+    }
+
+    /// @brief Get number of elements (same in every replica)
+    [[nodiscard]] size_type size() const {
+        return read([](const replica_type& cache) { return cache.size(); });
+    }
+
+    /// @brief Check if container is empty
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// @brief Get capacity of every replica
+    [[nodiscard]] size_type capacity() const {
+        return read([](const replica_type& cache) { return cache.capacity(); });
+    }
+
+    /// @brief Get number of replicas
+    [[nodiscard]] size_type replica_count() const noexcept { return replicas_.size(); }
+
+    /// @brief Get the replica serving the calling thread
+    [[nodiscard]] size_type local_replica() const noexcept {
+        return static_cast<size_type>(numa::current_node()) % replicas_.size();
+    }
+
+private:
+    struct alignas(detail::kCacheLineSize) Replica {
+        Replica(size_type capacity, const Allocator& allocator) : cache(capacity, allocator) {}
+
+        mutable std::shared_mutex mutex;
+        replica_type cache;
+    };
+
+    /// Apply a write to all replicas in the same order; returns f's result on the first
+    template <typename F>
+    bool for_each_replica(F&& f) {
+        std::lock_guard writer_lock(writer_mutex_);
+        bool result = false;
+        for (size_type i = 0; i < replicas_.size(); ++i) {
+            std::unique_lock lock(replicas_[i]->mutex);
+            const bool replica_result = f(replicas_[i]->cache);
+            if (i == 0) {
+                result = replica_result;
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::unique_ptr<Replica>> replicas_;
+    std::mutex writer_mutex_;
+};
+
+}  // namespace multi_index_lru
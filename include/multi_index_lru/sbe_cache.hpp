@@ -19,8 +19,10 @@
 
 #include <multi_index_lru/container.hpp>
 #include <multi_index_lru/expirable_container.hpp>
+#include <multi_index_lru/memory_usage.hpp>
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <span>
@@ -59,6 +61,11 @@ struct SbeEntry {
     [[nodiscard]] std::span<const uint8_t> raw_data() const noexcept {
         return std::span<const uint8_t>(data);
     }
+
+    /// @brief Heap bytes of the owned buffer and keys, for memory_usage() accounting
+    friend std::size_t heap_bytes(const SbeEntry& entry) {
+        return multi_index_lru::heap_bytes(entry.data) + detail::tuple_payload_bytes(entry.keys);
+    }
 };
 
 /// @brief Helper alias to define SbeEntry with key types
@@ -101,16 +108,21 @@ public:
         : view_factory_(std::move(view_factory)), extractors_(std::move(extractors)...)
     {}
 
+    /// @brief Extract index keys from raw SBE bytes
+    keys_type extract_keys(std::span<const uint8_t> data) const {
+        auto view = std::invoke(view_factory_, data);
+        return extract_impl(view, std::index_sequence_for<Extractors...>{});
+    }
+
     /// @brief Build an entry from raw SBE bytes (bytes are copied into entry ownership)
     Entry build(std::span<const uint8_t> data) const {
-        auto view = std::invoke(view_factory_, data);
-        return build_impl(view, data, std::index_sequence_for<Extractors...>{});
+        return Entry(extract_keys(data), data);
     }
 
 private:
     template <typename View, std::size_t... Is>
-    Entry build_impl(const View& view, std::span<const uint8_t> data, std::index_sequence<Is...>) const {
-        return Entry(keys_type(std::get<Is>(extractors_)(view)...), data);
+    keys_type extract_impl(const View& view, std::index_sequence<Is...>) const {
+        return keys_type(std::get<Is>(extractors_)(view)...);
     }
 
     ViewFactory view_factory_;
@@ -144,4 +156,65 @@ auto make_sbe_field(Accessor accessor) {
     return sbe_field<T, Accessor>(std::move(accessor));
 }
 
+/// @brief Outcome of update_payload()
+enum class SbeUpdateResult {
+    not_found,  ///< No entry with the key (or it expired)
+    updated,    ///< Payload changed in place, index keys unchanged
+    rekeyed,    ///< Payload changed and the entry was re-indexed under new keys
+    erased      ///< New keys collided with another entry; the updated entry was removed
+};
+
+/// @brief Mutate the stored SBE bytes of an entry in place
+/// @tparam Tag Index tag used to find the entry
+/// @param cache Container or ExpirableContainer of SbeEntry values
+/// @param key Key of the entry to update
+/// @param builder Builder whose extract_keys() re-reads keys from the bytes
+///                (SbeEntryBuilder or FixedSbeEntryBuilder)
+/// @param mutator Called as mutator(std::span<uint8_t>) on the owned payload;
+///                must not change its size
+/// @return What happened to the entry
+///
+/// Meant for updates of non-key fields (prices, quantities, flags) written
+/// through an SBE encoder wrapping the span, or plain stores at fixed
+/// offsets. No bytes are copied and the entry is not reinserted: after the
+/// mutation, keys are re-extracted and compared with the stored ones, and
+/// when they match every index is left untouched. If the mutation did change
+/// a key field, the entry is re-indexed under the new keys. The entry moves
+/// to the front of the LRU list (and its timestamp is refreshed for
+/// ExpirableContainer).
+///
+/// Example usage:
+/// @code
+/// auto result = multi_index_lru::update_payload<SecurityIdTag>(cache, security_id, builder,
+///     [&](std::span<uint8_t> bytes) {
+///         market::Quote quote;
+///         quote.wrapForDecode(reinterpret_cast<char*>(bytes.data()), 8,
+///                             market::Quote::sbeBlockLength(), market::Quote::sbeSchemaVersion(),
+///                             bytes.size());
+///         quote.bidPrice(new_bid);
+///     });
+/// @endcode
+template <typename Tag, typename Cache, typename Builder, typename Mutator>
+    requires std::invocable<Mutator&, std::span<uint8_t>>
+SbeUpdateResult update_payload(Cache& cache, const auto& key, const Builder& builder, Mutator&& mutator) {
+    bool visited = false;
+    bool rekeyed = false;
+    const bool present = cache.template modify<Tag>(key, [&](auto& entry) {
+        visited = true;
+        mutator(std::span<uint8_t>(entry.data));
+        auto keys = builder.extract_keys(entry.raw_data());
+        if (keys != entry.keys) {
+            entry.keys = std::move(keys);
+            rekeyed = true;
+        }
+    });
+    if (!visited) {
+        return SbeUpdateResult::not_found;
+    }
+    if (!present) {
+        return SbeUpdateResult::erased;
+    }
+    return rekeyed ? SbeUpdateResult::rekeyed : SbeUpdateResult::updated;
+}
+
 }  // namespace multi_index_lru
@@ -0,0 +1,270 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/sbe_fixed.hpp
+/// @brief Key extraction from fixed offsets of SBE messages, with batched SIMD gathers
+///
+/// SBE fixed-length fields of the root block sit at offsets known from the
+/// schema, so keys can be read straight from the bytes without building a
+/// view. Column extraction uses AVX2 gathers when the translation unit is
+/// compiled with AVX2 enabled (e.g. -mavx2 or -march=native) and a scalar
+/// loop otherwise; both produce identical results.
+
+#include <multi_index_lru/sbe_cache.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace multi_index_lru {
+
+/// Size of the standard SBE message header (blockLength, templateId, schemaId, version)
+inline constexpr std::size_t sbe_message_header_size = 8;
+
+namespace detail {
+
+/// Read a little-endian integer from unaligned bytes
+template <typename T>
+T load_little_endian(const std::uint8_t* bytes) noexcept {
+    if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    } else {
+        using U = std::make_unsigned_t<T>;
+        U value = 0;
+        for (std::size_t i = sizeof(T); i-- > 0;) {
+            value = static_cast<U>((value << 8U) | bytes[i]);
+        }
+        return static_cast<T>(value);
+    }
+}
+
+}  // namespace detail
+
+/// @brief Fixed-length integer field at a compile-time byte offset
+/// @tparam T Field type (integral, 1, 2, 4 or 8 bytes, little-endian on the wire)
+/// @tparam Offset Byte offset from the start of the message (including the header)
+///
+/// For `example/schemas/market_cache.xml`, the quote's fields follow the
+/// 8-byte header:
+/// @code
+/// using QuoteTemplateId = multi_index_lru::sbe_fixed_field<std::uint16_t, 8>;
+/// using QuoteSecurityId = multi_index_lru::sbe_fixed_field<std::uint32_t, 10>;
+/// @endcode
+template <typename T, std::size_t Offset>
+    requires std::integral<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+struct sbe_fixed_field {
+    using result_type = T;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t size = sizeof(T);
+
+    /// Read the field; the caller guarantees bytes.size() >= Offset + sizeof(T)
+    T operator()(std::span<const std::uint8_t> bytes) const noexcept {
+        return detail::load_little_endian<T>(bytes.data() + Offset);
+    }
+};
+
+namespace detail {
+
+template <typename Field>
+void gather_field_scalar(const std::uint8_t* base, std::span<const std::uint32_t> offsets,
+                         typename Field::result_type* out) noexcept {
+    using T = typename Field::result_type;
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        out[i] = load_little_endian<T>(base + offsets[i] + Field::offset);
+    }
+}
+
+#if defined(__AVX2__)
+template <typename Field>
+void gather_field_avx2(const std::uint8_t* base, std::span<const std::uint32_t> offsets,
+                       typename Field::result_type* out) noexcept {
+    using T = typename Field::result_type;
+    const auto count = offsets.size();
+    std::size_t i = 0;
+    if constexpr (sizeof(T) == 8) {
+        const auto field = _mm_set1_epi32(static_cast<int>(Field::offset));
+        for (; i + 4 <= count; i += 4) {
+            const auto index = _mm_add_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets.data() + i)), field);
+            const auto values = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(base), index, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+        }
+    } else {
+        // Narrow fields are gathered as the 32-bit word ending at the field
+        // (never reading past it) and shifted down
+        constexpr std::size_t word_start = Field::offset + sizeof(T) - 4;
+        constexpr int shift = static_cast<int>(8 * (4 - sizeof(T)));
+        const auto field = _mm256_set1_epi32(static_cast<int>(word_start));
+        alignas(32) std::uint32_t words[8];
+        for (; i + 8 <= count; i += 8) {
+            const auto index = _mm256_add_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets.data() + i)), field);
+            auto values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), index, 1);
+            if constexpr (shift != 0) {
+                values = _mm256_srli_epi32(values, shift);
+            }
+            if constexpr (sizeof(T) == 4) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+            } else {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(words), values);
+                for (std::size_t lane = 0; lane < 8; ++lane) {
+                    out[i + lane] = static_cast<T>(words[lane]);
+                }
+            }
+        }
+    }
+    gather_field_scalar<Field>(base, offsets.subspan(i), out + i);
+}
+#endif
+
+/// Gather one field from many messages; offsets must already be bounds-checked
+template <typename Field>
+void gather_field(std::span<const std::uint8_t> buffer, std::span<const std::uint32_t> offsets,
+                  typename Field::result_type* out) noexcept {
+#if defined(__AVX2__)
+    // Narrow fields need 4 readable bytes ending at the field. Gather indices
+    // are signed 32-bit, which every in-bounds offset fits below 2 GiB.
+    if constexpr (sizeof(typename Field::result_type) == 8 ||
+                  Field::offset + sizeof(typename Field::result_type) >= 4) {
+        if (buffer.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+            gather_field_avx2<Field>(buffer.data(), offsets, out);
+            return;
+        }
+    }
+#endif
+    gather_field_scalar<Field>(buffer.data(), offsets, out);
+}
+
+}  // namespace detail
+
+/// @brief Builder reading keys from fixed offsets of raw SBE bytes
+///
+/// Replaces SbeEntryBuilder when all key fields are fixed-length fields of
+/// the root block: no view is built and each key is a single unaligned load.
+///
+/// @tparam Entry SbeEntry type whose keys match the fields, in order
+/// @tparam Fields sbe_fixed_field types
+///
+/// Example usage:
+/// @code
+/// using QuoteEntry = multi_index_lru::SbeEntryWithKeys_t<std::uint16_t, std::uint32_t>;
+/// multi_index_lru::FixedSbeEntryBuilder<QuoteEntry,
+///     multi_index_lru::sbe_fixed_field<std::uint16_t, 8>,
+///     multi_index_lru::sbe_fixed_field<std::uint32_t, 10>> builder;
+///
+/// cache.insert(builder.build(message_bytes));
+/// @endcode
+template <typename Entry, typename... Fields>
+class FixedSbeEntryBuilder {
+    static_assert(sizeof...(Fields) == Entry::key_count, "One field per entry key is required");
+
+public:
+    using keys_type = typename Entry::keys_type;
+
+    /// Minimum message size that contains every key field
+    static constexpr std::size_t min_message_size = std::max({std::size_t{0}, (Fields::offset + Fields::size)...});
+
+    /// @brief Extract keys from raw bytes
+    /// @throws std::out_of_range if the message is shorter than min_message_size
+    keys_type extract_keys(std::span<const std::uint8_t> data) const {
+        check_size(data.size());
+        return extract_impl(data, std::index_sequence_for<Fields...>{});
+    }
+
+    /// @brief Build an entry from raw bytes (bytes are copied into entry ownership)
+    /// @throws std::out_of_range if the message is shorter than min_message_size
+    Entry build(std::span<const std::uint8_t> data) const {
+        return Entry(extract_keys(data), data);
+    }
+
+    /// @brief Extract keys of many messages stored in one buffer
+    /// @param buffer Bytes holding all messages (e.g. a received packet)
+    /// @param offsets Start offset of every message within buffer
+    /// @param out Receives the keys of message i at out[i]; size >= offsets.size()
+    /// @throws std::out_of_range if a message's key fields lie outside buffer
+    ///         or out is too small
+    ///
+    /// Bounds are validated once for the whole batch. Keys of one message are
+    /// adjacent in memory, so per-message loads beat gathers followed by a
+    /// transpose here; use extract_column() for column-wise consumers.
+    void extract_keys_batch(std::span<const std::uint8_t> buffer, std::span<const std::uint32_t> offsets,
+                            std::span<keys_type> out) const {
+        check_batch(buffer, offsets, out.size());
+        for (std::size_t i = 0; i < offsets.size(); ++i) {
+            out[i] = extract_impl(buffer.subspan(offsets[i]), std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    /// @brief Extract one key of many messages into a column
+    /// @tparam I Key index
+    /// @param buffer Bytes holding all messages
+    /// @param offsets Start offset of every message within buffer
+    /// @param out Receives key I of message i at out[i]; size >= offsets.size()
+    /// @throws std::out_of_range as extract_keys_batch()
+    ///
+    /// Uses AVX2 gathers (8 messages per instruction for fields up to 4
+    /// bytes) when compiled with AVX2 support, for buffers below 2 GiB. Suited
+    /// to consumers that work on one key at a time, such as hashing routing
+    /// keys for a whole batch.
+    template <std::size_t I>
+    void extract_column(std::span<const std::uint8_t> buffer, std::span<const std::uint32_t> offsets,
+                        std::span<std::tuple_element_t<I, std::tuple<typename Fields::result_type...>>> out) const {
+        check_batch(buffer, offsets, out.size());
+        detail::gather_field<std::tuple_element_t<I, std::tuple<Fields...>>>(buffer, offsets, out.data());
+    }
+
+private:
+    template <std::size_t... I>
+    static keys_type extract_impl(std::span<const std::uint8_t> data, std::index_sequence<I...>) {
+        return keys_type(static_cast<std::tuple_element_t<I, keys_type>>(Fields{}(data))...);
+    }
+
+    static void check_size(std::size_t size) {
+        if (size < min_message_size) {
+            throw std::out_of_range("SBE message too short for key fields");
+        }
+    }
+
+    static void check_batch(std::span<const std::uint8_t> buffer, std::span<const std::uint32_t> offsets,
+                            std::size_t out_size) {
+        if (out_size < offsets.size()) {
+            throw std::out_of_range("Output span is smaller than the number of messages");
+        }
+        const auto limit = buffer.size() < min_message_size ? 0 : buffer.size() - min_message_size;
+        const bool in_bounds = buffer.size() >= min_message_size &&
+            std::all_of(offsets.begin(), offsets.end(), [limit](std::uint32_t offset) { return offset <= limit; });
+        if (!in_bounds) {
+            throw std::out_of_range("SBE message too short for key fields");
+        }
+    }
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,974 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/sharded_container.hpp
+/// @brief Thread-safe LRU container partitioned into independently locked shards
+
+#include <multi_index_lru/container.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+/// Routing helpers derived from the first user index of a Container
+template <typename Shard>
+struct shard_routing {
+    using boost_container = std::remove_cvref_t<decltype(std::declval<Shard&>().get_container())>;
+    // Index 0 is the LRU sequenced index added by Container
+    using route_index = typename boost_container::template nth_index<1>::type;
+    using key_from_value = typename route_index::key_from_value;
+    using key_type = typename route_index::key_type;
+
+    template <typename Tag>
+    static constexpr bool is_routed_tag = std::is_same_v<
+        typename boost_container::template index<Tag>::type, route_index>;
+
+    static std::uint64_t hash_key(const key_type& key) {
+        return mix_hash(boost::hash<key_type>{}(key));
+    }
+
+    template <typename Value>
+    static std::uint64_t hash_value(const Value& value) {
+        return hash_key(key_from_value{}(value));
+    }
+};
+
+/// Threads inside a ShardedContainer operation, counted per container
+///
+/// Each thread counts itself on one of kStripes cache lines, in the counter
+/// of the current phase. A table unlinked at some point can be freed once
+/// each counter of both phases has been seen at zero after that point: a
+/// thread that loaded the table earlier was counted before and stays
+/// counted until it leaves. flip() moves new readers to the other phase,
+/// so the counters a reclamation waits for drain under steady traffic.
+/// There is no limit on the number of reader threads.
+class TableReaders {
+public:
+    static constexpr std::size_t kStripes = 16;
+
+    /// Counts the calling thread as a reader for its lifetime
+    class Guard {
+    public:
+        explicit Guard(const TableReaders& readers) noexcept : counter_(&readers.enter()) {}
+        ~Guard() { counter_->fetch_sub(1, std::memory_order_release); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        std::atomic<std::size_t>* counter_;
+    };
+
+    /// Phase new readers are counted in
+    unsigned phase() const noexcept { return phase_.load(std::memory_order_relaxed); }
+
+    /// Count new readers in the other phase
+    void flip() noexcept { phase_.store(phase() ^ 1U, std::memory_order_relaxed); }
+
+    /// Check whether no reader is counted in phase. The caller unlinked the
+    /// tables it waits for with seq_cst stores.
+    bool idle(unsigned phase) const noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return std::all_of(stripes_.begin(), stripes_.end(), [phase](const Stripe& stripe) {
+            return stripe.counts[phase].load(std::memory_order_acquire) == 0;
+        });
+    }
+
+private:
+    struct alignas(kCacheLineSize) Stripe {
+        std::array<std::atomic<std::size_t>, 2> counts{};
+    };
+
+    static std::size_t stripe() noexcept {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % kStripes;
+        return index;
+    }
+
+    std::atomic<std::size_t>& enter() const noexcept {
+        auto& counter = stripes_[stripe()].counts[phase()];
+        counter.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in idle(): either the table loads that follow
+        // see an unlink, or idle() sees this reader
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return counter;
+    }
+
+    mutable std::array<Stripe, kStripes> stripes_;
+    std::atomic<unsigned> phase_{0};
+};
+
+/// Capacity of shard `index` of `shards`: the first total % shards shards
+/// take one element more, so the capacities add up to total (every shard
+/// holds at least one element, though, when total < shards)
+inline std::size_t shard_capacity(std::size_t total, std::size_t shards, std::size_t index) noexcept {
+    return std::max<std::size_t>(total / shards + (index < total % shards ? 1 : 0), 1);
+}
+
+}  // namespace detail
+
+/// @brief LRU container split into shards, each guarded by its own mutex
+///
+/// Elements are routed to a shard by hashing the key of the first index in
+/// IndexSpecifierList. Lookups through that index touch a single shard;
+/// lookups through any other index visit every shard. LRU order and capacity
+/// are maintained per shard, so eviction is an approximation of global LRU.
+///
+/// Because every shard is a separate Container, a rehash of a hashed index
+/// only ever touches one shard's elements. When constructed with
+/// reserve_buckets, growing the capacity does not rehash anything up front:
+/// each shard re-reserves its buckets on its next access (or through
+/// rehash_step()), so the longest pause is bounded by the shard size.
+///
+/// The shard count can be changed online with reshard(): the new shards
+/// take over immediately and elements are moved over from the old ones in
+/// bounded batches (migrate_step()), while lookups keep finding elements in
+/// whichever shard holds them. Drained shards are freed once no thread can
+/// still be looking at them: every operation counts itself as a reader of
+/// the shard tables while it runs (see reclaim()).
+///
+/// All lookups return copies (or run a visitor under the shard lock), since
+/// iterators cannot outlive the lock that protects them.
+///
+/// @tparam Value The value type stored in the container
+/// @tparam IndexSpecifierList boost::multi_index::indexed_by<...>; the first index must be keyed
+/// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+///
+/// Example usage:
+/// @code
+/// using SharedCache = multi_index_lru::ShardedContainer<
+///     MyValue,
+///     boost::multi_index::indexed_by<
+///         boost::multi_index::hashed_unique<
+///             boost::multi_index::tag<KeyTag>,
+///             boost::multi_index::member<MyValue, std::string, &MyValue::key>>>>;
+///
+/// SharedCache cache(1'000'000, 16);  // 1M elements over 16 shards
+/// cache.emplace(MyValue{"key1", 42});
+/// std::optional<MyValue> hit = cache.find<KeyTag>(std::string("key1"));
+/// @endcode
+template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>>
+class ShardedContainer {
+public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using shard_type = Container<Value, IndexSpecifierList, Allocator>;
+
+private:
+    using routing = detail::shard_routing<shard_type>;
+
+public:
+    /// Key type of the first index, which elements are routed by
+    using route_key_type = typename routing::key_type;
+
+    /// Whether lookups through Tag are routed to a single shard
+    template <typename Tag>
+    static constexpr bool is_routed_tag = routing::template is_routed_tag<Tag>;
+
+    /// @brief Construct container with total capacity split over shards
+    /// @param max_size Maximum number of elements across all shards
+    /// @param shard_count Number of shards (must be positive)
+    /// @param reserve_buckets Size all hashed indices of every shard up front
+    ShardedContainer(size_type max_size, size_type shard_count, bool reserve_buckets = false)
+        : ShardedContainer(max_size, shard_count,
+                           [](size_type) { return Allocator(); }, reserve_buckets)
+    {}
+
+    /// @brief Construct container with a separate allocator per shard
+    /// @param max_size Maximum number of elements across all shards
+    /// @param shard_count Number of shards (must be positive)
+    /// @param make_allocator Called as make_allocator(shard_index) for every shard
+    /// @param reserve_buckets Size all hashed indices of every shard up front
+    ///
+    /// Used to place each shard's nodes on a NUMA node, e.g. with
+    /// `[](std::size_t i) { return NumaAllocator<Value>(numa::node_for_shard(i)); }`.
+    /// Each shard structure is allocated by the constructing thread, so with
+    /// first-touch placement construct from a thread on the shard's node or
+    /// rely on the allocator for the elements.
+    template <typename AllocatorFactory>
+        requires std::is_invocable_r_v<Allocator, AllocatorFactory&, size_type>
+    ShardedContainer(size_type max_size, size_type shard_count,
+                     AllocatorFactory make_allocator, bool reserve_buckets = false)
+        : max_size_(max_size), reserve_buckets_(reserve_buckets)
+    {
+        if (max_size == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        if (shard_count == 0) {
+            throw std::invalid_argument("Shard count must be greater than 0");
+        }
+        tables_.push_back(make_table(shard_count, make_allocator, false));
+        table_.store(tables_.back().get(), std::memory_order_release);
+    }
+
+    /// @brief Emplace a new element
+    /// @param args Arguments forwarded to value constructor
+    /// @return true if element was newly inserted, false if existing element was refreshed
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        Value value(std::forward<Args>(args)...);
+        return with_owner(typename routing::key_from_value{}(value), [&](Shard& shard) {
+            prepare(shard);
+            return bump_if(shard, shard.cache.emplace(std::move(value)));
+        });
+    }
+
+    /// @brief Insert a value (copy)
+    bool insert(const Value& value) {
+        return with_owner(typename routing::key_from_value{}(value), [&](Shard& shard) {
+            prepare(shard);
+            return bump_if(shard, shard.cache.insert(value));
+        });
+    }
+
+    /// @brief Insert a value (move)
+    bool insert(Value&& value) {
+        return with_owner(typename routing::key_from_value{}(value), [&](Shard& shard) {
+            prepare(shard);
+            return bump_if(shard, shard.cache.insert(std::move(value)));
+        });
+    }
+
+    /// @brief Insert a value, or replace the element that has the same keys
+    /// @param value Value to insert
+    /// @return true if newly inserted, false if an existing element was replaced
+    ///
+    /// Unlike insert(), an element with the same first-index key is
+    /// overwritten. The element is moved to the front of the LRU order either
+    /// way. Throws std::invalid_argument if the value collides with a
+    /// different element on another unique index.
+    bool insert_or_assign(Value value) {
+        const auto& key = typename routing::key_from_value{}(value);
+        return with_owner(key, [&](Shard& shard) {
+            prepare(shard);
+            auto& container = shard.cache.get_container();
+            auto& seq_index = shard.cache.get_sequenced();
+            auto& route_index = container.template get<1>();
+            auto it = route_index.find(key);
+            if (it != route_index.end()) {
+                shard.cache.account_erase(*it);
+                if (!route_index.replace(it, std::move(value))) {
+                    shard.cache.account_insert(*it);
+                    throw std::invalid_argument("Replacement collides with another element");
+                }
+                shard.cache.account_insert(*it);
+                seq_index.relocate(seq_index.begin(), container.template project<0>(it));
+                bump(shard);
+                return false;
+            }
+            if (!seq_index.push_front(std::move(value)).second) {
+                throw std::invalid_argument("Value collides with another element");
+            }
+            shard.cache.account_insert(seq_index.front());
+            if (seq_index.size() > shard.cache.capacity()) {
+                shard.cache.evict_lru();
+            }
+            bump(shard);
+            return true;
+        });
+    }
+
+    /// @brief Find element by key and return a copy
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @return Copy of the element, or std::nullopt if not found
+    ///
+    /// Finding an element moves it to the front of its shard's LRU order.
+    template <typename Tag>
+    std::optional<Value> find(const auto& key) {
+        std::optional<Value> result;
+        this->template visit<Tag>(key, [&result](const Value& value) { result = value; });
+        return result;
+    }
+
+    /// @brief Find element by key without updating LRU position
+    /// @return Copy of the element, or std::nullopt if not found
+    template <typename Tag>
+    std::optional<Value> find_no_update(const auto& key) const {
+        std::optional<Value> result;
+        this->template visit_no_update<Tag>(key, [&result](const Value& value) { result = value; });
+        return result;
+    }
+
+    /// @brief Run a visitor on the element with given key under the shard lock
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @param visitor Called as visitor(const Value&) if the element exists
+    /// @return true if the element was found
+    ///
+    /// Avoids copying the value. The visitor must not call back into the
+    /// container. Finding an element moves it to the front of the LRU order.
+    template <typename Tag, typename Visitor>
+    bool visit(const auto& key, Visitor&& visitor) {
+        return find_in_shards<Tag>(key, [&](Shard& shard) {
+            auto& cache = shard.cache;
+            auto it = cache.template find<Tag>(key);
+            if (it == cache.template end<Tag>()) {
+                return false;
+            }
+            visitor(static_cast<const Value&>(*it));
+            return true;
+        });
+    }
+
+    /// @brief Run a visitor on the element with given key without updating LRU position
+    template <typename Tag, typename Visitor>
+    bool visit_no_update(const auto& key, Visitor&& visitor) const {
+        return find_in_shards<Tag>(key, [&](const Shard& shard) {
+            const auto& cache = shard.cache;
+            auto it = cache.template find_no_update<Tag>(key);
+            if (it == cache.template end<Tag>()) {
+                return false;
+            }
+            visitor(static_cast<const Value&>(*it));
+            return true;
+        });
+    }
+
+    /// @brief Check if element exists by key (refreshes LRU position)
+    template <typename Tag>
+    bool contains(const auto& key) {
+        return this->template visit<Tag>(key, [](const Value&) {});
+    }
+
+    /// @brief Check if element exists by key without updating LRU position
+    template <typename Tag>
+    bool contains_no_update(const auto& key) const {
+        return this->template visit_no_update<Tag>(key, [](const Value&) {});
+    }
+
+    /// @brief Erase element(s) by key
+    /// @return true if at least one element was erased
+    template <typename Tag>
+    bool erase(const auto& key) {
+        if constexpr (routing::template is_routed_tag<Tag>) {
+            return with_owner(key, [&](Shard& shard) {
+                return bump_if(shard, shard.cache.template erase<Tag>(key));
+            });
+        } else {
+            bool erased = false;
+            for_each_shard([&](Shard& shard) {
+                erased = bump_if(shard, shard.cache.template erase<Tag>(key)) || erased;
+                return false;
+            });
+            return erased;
+        }
+    }
+
+    /// @brief Get current number of elements (sum over shards)
+    ///
+    /// Shards are locked one at a time, so under concurrent modification
+    /// the result is only a snapshot.
+    [[nodiscard]] size_type size() const {
+        size_type total = 0;
+        for_each_shard([&total](const Shard& shard) {
+            total += shard.cache.size();
+            return false;
+        });
+        return total;
+    }
+
+    /// @brief Check if container is empty
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// @brief Get the bytes used by all shards (see Container::memory_usage())
+    ///
+    /// Includes old shards still being drained by a reshard. Shards are
+    /// locked one at a time, so under concurrent modification the result is
+    /// only a snapshot.
+    [[nodiscard]] MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        for_each_shard([&usage](const Shard& shard) {
+            usage += shard.cache.memory_usage();
+            return false;
+        });
+        return usage;
+    }
+
+    /// @brief Get current total capacity
+    [[nodiscard]] size_type capacity() const noexcept {
+        return max_size_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get number of shards
+    [[nodiscard]] size_type shard_count() const noexcept {
+        ReaderGuard guard(readers_);
+        return current_shards().size();
+    }
+
+    /// @brief Set new total capacity
+    /// @param new_capacity New maximum number of elements across all shards
+    ///
+    /// Shrinking evicts LRU elements of each shard immediately. Growing only
+    /// records the new bucket size; with reserve_buckets, each shard rehashes
+    /// on its next access or in rehash_step().
+    void set_capacity(size_type new_capacity) {
+        if (new_capacity == 0) {
+            throw std::invalid_argument("Container capacity must be greater than 0");
+        }
+        std::lock_guard guard(reshard_mutex_);
+        const auto& shards = current_shards();
+        for (size_type i = 0; i < shards.size(); ++i) {
+            auto& shard = shards[i];
+            const auto per_shard = detail::shard_capacity(new_capacity, shards.size(), i);
+            std::lock_guard lock(shard->mutex);
+            if (reserve_buckets_ && per_shard > shard->cache.capacity()) {
+                shard->pending_reserve = per_shard;
+            }
+            const auto before = shard->cache.size();
+            shard->cache.set_capacity(per_shard);
+            bump_if(*shard, shard->cache.size() != before);
+        }
+        max_size_.store(new_capacity, std::memory_order_relaxed);
+    }
+
+    /// @brief Start changing the number of shards without flushing the cache
+    /// @param new_shard_count New number of shards (must be positive)
+    ///
+    /// The new shards take over at once: inserts go to them, and an access
+    /// through the first index first moves the element it is after from its
+    /// old shard. The remaining elements are moved by migrate_step() or
+    /// finish_migration(), most recently used first and behind the elements
+    /// already in their new shard; those that no longer fit are dropped as
+    /// the coldest. The total capacity is kept.
+    ///
+    /// A migration still in progress is finished first. Does nothing if
+    /// new_shard_count equals shard_count(). Shard indices and versions are
+    /// those of the new shards from here on, so FrontCache entries taken
+    /// before are refetched.
+    void reshard(size_type new_shard_count) {
+        reshard(new_shard_count, [](size_type) { return Allocator(); });
+    }
+
+    /// @brief Start changing the number of shards, with an allocator per new shard
+    /// @param new_shard_count New number of shards (must be positive)
+    /// @param make_allocator Called as make_allocator(shard_index) for every new shard
+    ///
+    /// Elements are moved by relinking their nodes when the old and new
+    /// shard allocators compare equal, and by moving the value otherwise
+    /// (e.g. NumaAllocator on different nodes).
+    template <typename AllocatorFactory>
+        requires std::is_invocable_r_v<Allocator, AllocatorFactory&, size_type>
+    void reshard(size_type new_shard_count, AllocatorFactory make_allocator) {
+        if (new_shard_count == 0) {
+            throw std::invalid_argument("Shard count must be greater than 0");
+        }
+        std::lock_guard guard(reshard_mutex_);
+        migrate_locked(std::numeric_limits<size_type>::max());
+        reclaim_locked();
+        auto* current = table_.load(std::memory_order_relaxed);
+        if (new_shard_count == current->shards.size()) {
+            return;
+        }
+        auto table = make_table(new_shard_count, make_allocator, true);
+        table->previous.store(current, std::memory_order_relaxed);
+        tables_.reserve(tables_.size() + 1);
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(current->shards.size());
+
+        // Retire every old shard and publish the new table under all old
+        // locks, so no operation can miss the switch half way
+        std::uint64_t version = 0;
+        for (auto& shard : current->shards) {
+            locks.emplace_back(shard->mutex);
+            shard->retired = true;
+            version = std::max(version, shard->version.load(std::memory_order_relaxed));
+        }
+        for (auto& shard : table->shards) {
+            shard->version.store(version + 1, std::memory_order_relaxed);
+        }
+        tables_.push_back(std::move(table));
+        table_.store(tables_.back().get(), std::memory_order_release);
+    }
+
+    /// @brief Move up to max_elements elements of an ongoing resharding
+    /// @param max_elements Maximum number of elements to move (must be positive)
+    /// @return true if elements remain in the old shards
+    ///
+    /// Intended for a maintenance thread. The call holds the lock of one old
+    /// shard at a time, and each destination shard's lock for a single move,
+    /// so max_elements bounds how long a request can wait.
+    bool migrate_step(size_type max_elements) {
+        if (max_elements == 0) {
+            throw std::invalid_argument("Migration batch size must be greater than 0");
+        }
+        std::lock_guard guard(reshard_mutex_);
+        return migrate_locked(max_elements);
+    }
+
+    /// @brief Move all remaining elements of an ongoing resharding
+    void finish_migration() {
+        std::lock_guard guard(reshard_mutex_);
+        migrate_locked(std::numeric_limits<size_type>::max());
+    }
+
+    /// @brief Free drained shards that no thread can still be looking at
+    /// @return Number of drained shard tables still waiting for threads
+    ///
+    /// Called automatically when a migration completes and on every
+    /// reshard(); call it explicitly to release memory sooner after a long
+    /// with_shard() or visitor call.
+    size_type reclaim() {
+        std::lock_guard guard(reshard_mutex_);
+        return reclaim_locked();
+    }
+
+    /// @brief Check whether a resharding is still migrating elements
+    [[nodiscard]] bool migrating() const noexcept {
+        return table_.load(std::memory_order_acquire)->previous.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// @brief Perform at most one deferred shard rehash
+    /// @return true if a shard was rehashed, false if none was pending
+    ///
+    /// Intended for a maintenance thread that wants to take rehash cost off
+    /// the request path after set_capacity() growth or reshard().
+    bool rehash_step() {
+        ReaderGuard guard(readers_);
+        for (auto& shard : current_shards()) {
+            std::lock_guard lock(shard->mutex);
+            if (shard->pending_reserve != 0) {
+                prepare(*shard);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Get number of shards with a deferred rehash
+    [[nodiscard]] size_type pending_rehashes() const {
+        ReaderGuard guard(readers_);
+        size_type pending = 0;
+        for (const auto& shard : current_shards()) {
+            std::lock_guard lock(shard->mutex);
+            pending += shard->pending_reserve != 0 ? 1 : 0;
+        }
+        return pending;
+    }
+
+    /// @brief Size every hashed index of every shard for n elements in total
+    void reserve(size_type n) {
+        std::lock_guard guard(reshard_mutex_);
+        const auto& shards = current_shards();
+        for (size_type i = 0; i < shards.size(); ++i) {
+            std::lock_guard lock(shards[i]->mutex);
+            shards[i]->cache.reserve(detail::shard_capacity(n, shards.size(), i));
+        }
+    }
+
+    /// @brief Set the max load factor of every hashed index of every shard
+    ///
+    /// Shards created later by reshard() use it as well.
+    void max_load_factor(float z) {
+        std::lock_guard guard(reshard_mutex_);
+        for (auto& shard : current_shards()) {
+            std::lock_guard lock(shard->mutex);
+            shard->cache.max_load_factor(z);
+        }
+        max_load_factor_ = z;
+    }
+
+    /// @brief Remove all elements
+    void clear() {
+        for_each_shard([](Shard& shard) {
+            shard.cache.clear();
+            bump(shard);
+            return false;
+        });
+    }
+
+    /// @brief Get the shard a value is routed to
+    [[nodiscard]] size_type shard_index(const Value& value) const {
+        ReaderGuard guard(readers_);
+        return routing::hash_value(value) % current_shards().size();
+    }
+
+    /// @brief Get the shard a key of the first index is routed to
+    [[nodiscard]] size_type shard_index_for_key(const route_key_type& key) const {
+        ReaderGuard guard(readers_);
+        return routing::hash_key(key) % current_shards().size();
+    }
+
+    /// @brief Get a shard's modification counter
+    /// @param index Shard index
+    ///
+    /// The counter changes whenever the shard's contents may have changed
+    /// (insertion, replacement, erasure, eviction, clear, with_shard()), but
+    /// not on LRU refreshes. Read before a lookup and compared later, it tells
+    /// whether a copy taken by that lookup may be stale. Loads are acquire.
+    ///
+    /// Shards created by reshard() start above every version of the shards
+    /// they replace, and an index out of range after a reshard reads as the
+    /// maximum value, which no shard reaches; either way old copies look stale.
+    [[nodiscard]] std::uint64_t shard_version(size_type index) const noexcept {
+        ReaderGuard guard(readers_);
+        const auto& shards = current_shards();
+        if (index >= shards.size()) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        return shards[index]->version.load(std::memory_order_acquire);
+    }
+
+    /// @brief Run a function on one shard under its lock
+    /// @param index Shard index in [0, shard_count())
+    /// @param f Called as f(shard_type&)
+    ///
+    /// An index from shard_index() or shard_count() only holds until the
+    /// next reshard(), which can run concurrently; call both inside
+    /// with_fixed_shards() to keep the layout. While a resharding migrates,
+    /// elements not moved yet are still held by the old shards: they are not
+    /// visible here, and inserting their keys here creates duplicates.
+    ///
+    /// Throws std::out_of_range if index is not below shard_count(), which a
+    /// concurrent reshard() to fewer shards can cause. If a reshard()
+    /// retires the shard while the call waits for its lock, f runs on the
+    /// shard with the same index in the new layout.
+    template <typename F>
+    decltype(auto) with_shard(size_type index, F&& f) {
+        ReaderGuard guard(readers_);
+        for (;;) {
+            auto& shard = *current_shards().at(index);
+            std::lock_guard lock(shard.mutex);
+            if (!shard.retired) {
+                prepare(shard);
+                bump(shard);
+                return f(shard.cache);
+            }
+        }
+    }
+
+    /// @brief Run a function on one shard under its lock (const)
+    template <typename F>
+    decltype(auto) with_shard(size_type index, F&& f) const {
+        ReaderGuard guard(readers_);
+        for (;;) {
+            const auto& shard = *current_shards().at(index);
+            std::lock_guard lock(shard.mutex);
+            if (!shard.retired) {
+                return f(static_cast<const shard_type&>(shard.cache));
+            }
+        }
+    }
+
+    /// @brief Run a function with the shard layout held fixed
+    /// @param f Called as f()
+    /// @return Whatever f returns
+    ///
+    /// Finishes a migration in progress, then keeps reshard() waiting until
+    /// f returns. Inside f, shard_count(), shard_index() and with_shard()
+    /// refer to the same shards, and every element sits in the shard
+    /// shard_index() routes it to. f (and threads it waits for) must not call
+    /// reshard(), migrate_step(), finish_migration(), set_capacity(),
+    /// reserve(), max_load_factor() or with_fixed_shards().
+    template <typename F>
+    decltype(auto) with_fixed_shards(F&& f) {
+        std::lock_guard guard(reshard_mutex_);
+        migrate_locked(std::numeric_limits<size_type>::max());
+        return f();
+    }
+
+private:
+    using node_type = typename shard_type::node_type;
+
+    struct alignas(detail::kCacheLineSize) Shard {
+        Shard(size_type capacity, const Allocator& allocator) : cache(capacity, allocator) {}
+
+        mutable std::mutex mutex;
+        shard_type cache;
+        size_type pending_reserve = 0;
+        // Set under the lock once a reshard replaced the shard's table
+        bool retired = false;
+        // Read by front caches on every hit; kept off the mutex's cache line
+        alignas(detail::kCacheLineSize) std::atomic<std::uint64_t> version{0};
+    };
+
+    struct Table {
+        std::vector<std::unique_ptr<Shard>> shards;
+        // Table being drained into this one; nullptr once its migration is done
+        std::atomic<Table*> previous{nullptr};
+
+        Shard& shard_for(std::uint64_t hash) const { return *shards[hash % shards.size()]; }
+    };
+
+    using ReaderGuard = detail::TableReaders::Guard;
+
+    struct RetiredTable {
+        std::unique_ptr<Table> table;
+        // Whether each reader phase was seen idle since the table was unlinked
+        std::array<bool, 2> drained{};
+    };
+
+    /// Record a modification; caller holds the shard lock. Retired shards
+    /// keep their last version, which their replacements start above.
+    static void bump(Shard& shard) noexcept {
+        if (!shard.retired) {
+            shard.version.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    static bool bump_if(Shard& shard, bool modified) noexcept {
+        if (modified) {
+            bump(shard);
+        }
+        return modified;
+    }
+
+    /// Apply a deferred bucket reservation; caller holds the shard lock
+    static void prepare(Shard& shard) {
+        if (shard.pending_reserve != 0) {
+            shard.cache.reserve(shard.pending_reserve);
+            shard.pending_reserve = 0;
+        }
+    }
+
+    template <typename AllocatorFactory>
+    std::unique_ptr<Table> make_table(size_type shard_count, AllocatorFactory& make_allocator,
+                                      bool defer_reserve) {
+        const auto max_size = max_size_.load(std::memory_order_relaxed);
+        auto table = std::make_unique<Table>();
+        table->shards.reserve(shard_count);
+        for (size_type i = 0; i < shard_count; ++i) {
+            const auto per_shard = detail::shard_capacity(max_size, shard_count, i);
+            auto shard = std::make_unique<Shard>(per_shard, make_allocator(i));
+            if (max_load_factor_) {
+                shard->cache.max_load_factor(*max_load_factor_);
+            }
+            if (reserve_buckets_ && defer_reserve) {
+                shard->pending_reserve = per_shard;
+            } else if (reserve_buckets_) {
+                shard->cache.reserve(per_shard);
+            }
+            table->shards.push_back(std::move(shard));
+        }
+        return table;
+    }
+
+    /// Caller holds a ReaderGuard or reshard_mutex_
+    const std::vector<std::unique_ptr<Shard>>& current_shards() const noexcept {
+        return table_.load(std::memory_order_acquire)->shards;
+    }
+
+    /// Lock the current shard for hash and call f(owner, source), where
+    /// source is the locked shard of the table being drained, if any. Old
+    /// shards are always locked before new ones.
+    template <typename F>
+    decltype(auto) lock_owner(std::uint64_t hash, F&& f) const {
+        ReaderGuard guard(readers_);
+        for (;;) {
+            auto* table = table_.load(std::memory_order_acquire);
+            auto* previous = table->previous.load(std::memory_order_acquire);
+            auto& owner = table->shard_for(hash);
+            Shard* source = nullptr;
+            std::unique_lock<std::mutex> source_lock;
+            if (previous != nullptr) {
+                source = &previous->shard_for(hash);
+                source_lock = std::unique_lock(source->mutex);
+            }
+            std::lock_guard lock(owner.mutex);
+            if (!owner.retired) {
+                return f(owner, source);
+            }
+            // Resharded since the table was loaded: retry on the new one
+        }
+    }
+
+    /// Call f(shard) on the shard that owns key, after moving the element
+    /// with that key over from the table being drained
+    template <typename F>
+    decltype(auto) with_owner(const auto& key, F&& f) {
+        return lock_owner(routing::hash_key(key), [&](Shard& owner, Shard* source) -> decltype(auto) {
+            if (source != nullptr) {
+                adopt(*source, owner, key);
+            }
+            return f(owner);
+        });
+    }
+
+    /// Run f(shard) under each shard's lock, old table first, until f
+    /// returns true. An element being migrated moves from a shard not yet
+    /// visited to one not yet visited, so it is not missed.
+    template <typename F>
+    bool for_each_shard(F&& f) const {
+        ReaderGuard guard(readers_);
+        auto* table = table_.load(std::memory_order_acquire);
+        auto* previous = table->previous.load(std::memory_order_acquire);
+        for (auto* visited : {previous, table}) {
+            if (visited == nullptr) {
+                continue;
+            }
+            for (auto& shard : visited->shards) {
+                std::lock_guard lock(shard->mutex);
+                if (f(*shard)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    template <typename Tag, typename Finder>
+    bool find_in_shards(const auto& key, Finder&& finder) {
+        if constexpr (routing::template is_routed_tag<Tag>) {
+            return with_owner(key, finder);
+        } else {
+            return for_each_shard(finder);
+        }
+    }
+
+    /// Does not migrate: a lookup without LRU update checks both shards
+    template <typename Tag, typename Finder>
+    bool find_in_shards(const auto& key, Finder&& finder) const {
+        if constexpr (routing::template is_routed_tag<Tag>) {
+            return lock_owner(routing::hash_key(key), [&](const Shard& owner, const Shard* source) {
+                return finder(owner) || (source != nullptr && finder(*source));
+            });
+        } else {
+            return for_each_shard(finder);
+        }
+    }
+
+    /// Move the element with key from a retired shard; caller holds both locks
+    static void adopt(Shard& source, Shard& owner, const auto& key) {
+        auto& route_index = source.cache.get_container().template get<1>();
+        auto it = route_index.find(key);
+        if (it != route_index.end()) {
+            transfer(owner, source.cache.extract(it), true);
+        }
+    }
+
+    /// Insert an element taken from a retired shard; caller holds the
+    /// owner's lock. A hot element goes to the front (evicting if full), a
+    /// cold one to the back if there is room. On a key collision the
+    /// owner's element is the newer one and is kept.
+    static void transfer(Shard& owner, node_type node, bool hot) {
+        auto& seq_index = owner.cache.get_sequenced();
+        if (!hot && seq_index.size() >= owner.cache.capacity()) {
+            return;
+        }
+        prepare(owner);
+        const auto position = hot ? seq_index.begin() : seq_index.end();
+        auto [it, inserted] = [&] {
+            if (node.get_allocator() == owner.cache.get_allocator()) {
+                auto result = seq_index.insert(position, std::move(node));
+                return std::pair{result.position, result.inserted};
+            }
+            return seq_index.insert(position, std::move(node.value()));
+        }();
+        if (!inserted) {
+            return;
+        }
+        owner.cache.account_insert(*it);
+        if (seq_index.size() > owner.cache.capacity()) {
+            owner.cache.evict_lru();
+        }
+        bump(owner);
+    }
+
+    /// Move up to budget elements from the table being drained; caller
+    /// holds reshard_mutex_. Returns true if elements remain.
+    bool migrate_locked(size_type budget) {
+        auto* table = table_.load(std::memory_order_relaxed);
+        auto* previous = table->previous.load(std::memory_order_relaxed);
+        if (previous == nullptr) {
+            return false;
+        }
+        for (; next_drain_ < previous->shards.size(); ++next_drain_) {
+            auto& source = *previous->shards[next_drain_];
+            std::lock_guard source_lock(source.mutex);
+            auto& seq_index = source.cache.get_sequenced();
+            for (; !seq_index.empty(); --budget) {
+                if (budget == 0) {
+                    return true;
+                }
+                auto& owner = table->shard_for(routing::hash_value(seq_index.front()));
+                std::lock_guard lock(owner.mutex);
+                transfer(owner, source.cache.extract(seq_index.begin()), false);
+            }
+            // Release the drained shard's buckets now; the shard itself
+            // stays alive for threads that may still hold a pointer to it
+            source.cache = shard_type(1, source.cache.get_allocator());
+        }
+        next_drain_ = 0;
+        table->previous.store(nullptr, std::memory_order_seq_cst);
+        retire(previous);
+        return false;
+    }
+
+    /// Keep a drained, unlinked table until no reader can still see it;
+    /// caller holds reshard_mutex_
+    void retire(Table* drained) {
+        auto it = std::find_if(tables_.begin(), tables_.end(),
+                               [drained](const auto& table) { return table.get() == drained; });
+        retired_.reserve(retired_.size() + 1);
+        retired_.push_back(RetiredTable{std::move(*it)});
+        tables_.erase(it);
+        reclaim_locked();
+    }
+
+    size_type reclaim_locked() {
+        if (retired_.empty()) {
+            return 0;
+        }
+        for (const unsigned phase : {0U, 1U}) {
+            if (readers_.idle(phase)) {
+                for (auto& retired : retired_) {
+                    retired.drained[phase] = true;
+                }
+            }
+        }
+        std::erase_if(retired_, [](const RetiredTable& retired) {
+            return retired.drained[0] && retired.drained[1];
+        });
+        // New readers move off the phase still to be seen idle
+        const auto phase = readers_.phase();
+        if (std::any_of(retired_.begin(), retired_.end(),
+                        [phase](const RetiredTable& retired) { return !retired.drained[phase]; })) {
+            readers_.flip();
+        }
+        return retired_.size();
+    }
+
+    // The current table and, during a migration, the one being drained
+    std::vector<std::unique_ptr<Table>> tables_;
+    std::atomic<Table*> table_{nullptr};
+    std::atomic<size_type> max_size_;
+    bool reserve_buckets_;
+    // Guarded by reshard_mutex_
+    std::optional<float> max_load_factor_;
+    size_type next_drain_ = 0;
+    std::vector<RetiredTable> retired_;
+    std::mutex reshard_mutex_;
+    detail::TableReaders readers_;
+};
+
+}  // namespace multi_index_lru
@@ -0,0 +1,285 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/snapshot_container.hpp
+/// @brief Read-copy-update publication of immutable container snapshots
+
+#include <multi_index_lru/container.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+namespace detail {
+
+/// @brief Process-wide epoch-based reclamation domain
+///
+/// Each reader thread claims one slot on first use and keeps it until it
+/// exits. Inside a read-side section the slot holds the global epoch seen on
+/// entry; outside it holds 0. An object retired at epoch E can be freed once
+/// no slot holds an epoch <= E.
+class EpochDomain {
+public:
+    /// Maximum number of threads that can read concurrently
+    static constexpr std::size_t kMaxReaders = 256;
+
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    /// Enter a read-side section (re-entrant)
+    void enter() {
+        auto& record = thread_record();
+        if (record.slot == nullptr) {
+            record.slot = claim_slot();
+        }
+        if (record.depth++ == 0) {
+            record.slot->epoch.store(global_epoch_.load());
+        }
+    }
+
+    /// Leave a read-side section
+    void leave() noexcept {
+        auto& record = thread_record();
+        if (--record.depth == 0) {
+            record.slot->epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    /// Advance the global epoch after publishing; returns the retire epoch
+    std::uint64_t advance() { return global_epoch_.fetch_add(1); }
+
+    /// Check whether an object retired at given epoch is unreachable
+    [[nodiscard]] bool is_quiescent(std::uint64_t retire_epoch) const {
+        return std::none_of(slots_.begin(), slots_.end(), [retire_epoch](const Slot& slot) {
+            const auto epoch = slot.epoch.load();
+            return epoch != 0 && epoch <= retire_epoch;
+        });
+    }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> in_use{false};
+    };
+
+    struct ThreadRecord {
+        Slot* slot = nullptr;
+        unsigned depth = 0;
+
+        ~ThreadRecord() {
+            if (slot != nullptr) {
+                slot->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    static ThreadRecord& thread_record() {
+        thread_local ThreadRecord record;
+        return record;
+    }
+
+    Slot* claim_slot() {
+        for (auto& slot : slots_) {
+            bool expected = false;
+            if (!slot.in_use.load(std::memory_order_relaxed) &&
+                slot.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &slot;
+            }
+        }
+        throw std::runtime_error("Too many concurrent snapshot reader threads");
+    }
+
+    std::atomic<std::uint64_t> global_epoch_{1};
+    std::array<Slot, kMaxReaders> slots_;
+};
+
+/// RAII read-side section of the EpochDomain
+class EpochGuard {
+public:
+    EpochGuard() { EpochDomain::instance().enter(); }
+    ~EpochGuard() { EpochDomain::instance().leave(); }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+}  // namespace detail
+
+/// @brief Container published as immutable snapshots for lock-free readers
+///
+/// Readers query the current snapshot without taking any lock: a read-side
+/// section only writes the reader's own epoch slot. Writers are serialized,
+/// build the next version (either by copying the current one in update() or
+/// by handing over a freshly built container in publish()) and atomically
+/// swap it in. Old versions are retired and freed once every reader that
+/// could still see them has left its read-side section.
+///
+/// Snapshots are never modified after publication, so LRU order is frozen
+/// and only the *_no_update lookups are offered. Writes copy the whole
+/// container and are meant for slowly changing data such as reference data
+/// refreshed periodically.
+///
+/// @tparam Value The value type stored in the container
+/// @tparam IndexSpecifierList boost::multi_index::indexed_by<...> specifying indices
+/// @tparam Allocator Allocator type (defaults to std::allocator<Value>)
+///
+/// Example usage:
+/// @code
+/// multi_index_lru::SnapshotContainer<Instrument, Indices> instruments(100'000);
+///
+/// // Writer (e.g. once a minute)
+/// InstrumentSnapshot next(100'000);
+/// for (auto& row : load_reference_data()) next.insert(row);
+/// instruments.publish(std::move(next));
+///
+/// // Readers, on any number of threads
+/// std::optional<Instrument> hit = instruments.find_no_update<SymbolTag>(symbol);
+/// @endcode
+template <typename Value, typename IndexSpecifierList, typename Allocator = std::allocator<Value>>
+class SnapshotContainer {
+public:
+    using value_type = Value;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using snapshot_type = Container<Value, IndexSpecifierList, Allocator>;
+
+    /// @brief Construct with an empty snapshot of given capacity
+    /// @param max_size Capacity of the initial snapshot
+    explicit SnapshotContainer(size_type max_size)
+        : current_(new snapshot_type(max_size))
+    {}
+
+    SnapshotContainer(const SnapshotContainer&) = delete;
+    SnapshotContainer& operator=(const SnapshotContainer&) = delete;
+
+    /// @brief Destroy all versions; no reader may be active
+    ~SnapshotContainer() {
+        delete current_.load();
+    }
+
+    /// @brief Run a function on the current snapshot without locking
+    /// @param reader Called as reader(const snapshot_type&)
+    /// @return Whatever reader returns
+    ///
+    /// The snapshot reference must not escape the call.
+    template <typename Reader>
+    decltype(auto) read(Reader&& reader) const {
+        detail::EpochGuard guard;
+        return reader(static_cast<const snapshot_type&>(*current_.load()));
+    }
+
+    /// @brief Find element in the current snapshot and return a copy
+    /// @tparam Tag Index tag type
+    /// @param key Key to search for
+    /// @return Copy of the element, or std::nullopt if not found
+    template <typename Tag>
+    std::optional<Value> find_no_update(const auto& key) const {
+        return read([&key](const snapshot_type& snapshot) -> std::optional<Value> {
+            auto it = snapshot.template find_no_update<Tag>(key);
+            if (it == snapshot.template end<Tag>()) {
+                return std::nullopt;
+            }
+            return *it;
+        });
+    }
+
+    /// @brief Check if element exists in the current snapshot
+    template <typename Tag>
+    bool contains_no_update(const auto& key) const {
+        return read([&key](const snapshot_type& snapshot) {
+            return snapshot.template contains_no_update<Tag>(key);
+        });
+    }
+
+    /// @brief Get number of elements in the current snapshot
+    [[nodiscard]] size_type size() const {
+        return read([](const snapshot_type& snapshot) { return snapshot.size(); });
+    }
+
+    /// @brief Copy the current snapshot, modify the copy and publish it
+    /// @param writer Called as writer(snapshot_type&) on the private copy
+    ///
+    /// Writers are serialized. Cost is a full copy of the container.
+    template <typename Writer>
+    void update(Writer&& writer) {
+        std::lock_guard lock(writer_mutex_);
+        auto next = std::make_unique<snapshot_type>(*current_.load());
+        writer(*next);
+        publish_locked(std::move(next));
+    }
+
+    /// @brief Publish a container built elsewhere as the new snapshot
+    /// @param next Replacement snapshot
+    void publish(snapshot_type next) {
+        std::lock_guard lock(writer_mutex_);
+        publish_locked(std::make_unique<snapshot_type>(std::move(next)));
+    }
+
+    /// @brief Free retired snapshots that no reader can still see
+    /// @return Number of snapshots still waiting for readers
+    ///
+    /// Called automatically on every publication; call it explicitly to
+    /// release memory sooner after a long read-side section.
+    size_type reclaim() {
+        std::lock_guard lock(writer_mutex_);
+        return reclaim_locked();
+    }
+
+    /// @brief Get number of retired snapshots not yet freed
+    [[nodiscard]] size_type retired_count() const {
+        std::lock_guard lock(writer_mutex_);
+        return retired_.size();
+    }
+
+private:
+    struct Retired {
+        std::unique_ptr<snapshot_type> snapshot;
+        std::uint64_t epoch;
+    };
+
+    void publish_locked(std::unique_ptr<snapshot_type> next) {
+        std::unique_ptr<snapshot_type> previous(current_.exchange(next.release()));
+        const auto epoch = detail::EpochDomain::instance().advance();
+        retired_.push_back(Retired{std::move(previous), epoch});
+        reclaim_locked();
+    }
+
+    size_type reclaim_locked() {
+        const auto& domain = detail::EpochDomain::instance();
+        std::erase_if(retired_, [&domain](const Retired& retired) {
+            return domain.is_quiescent(retired.epoch);
+        });
+        return retired_.size();
+    }
+
+    std::atomic<snapshot_type*> current_;
+    mutable std::mutex writer_mutex_;
+    std::vector<Retired> retired_;
+};
+
+}  // namespace multi_index_lru
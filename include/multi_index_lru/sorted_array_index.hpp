@@ -0,0 +1,330 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+/// @file multi_index_lru/sorted_array_index.hpp
+/// @brief Ordered secondary index kept as a sorted array plus a small delta buffer
+
+#include <multi_index_lru/lazy_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace multi_index_lru {
+
+/// @brief Ordered index over element pointers stored in sorted arrays
+///
+/// Entries (a copy of the key and a pointer to the element) live in one
+/// sorted array, so lower_bound is a binary search over contiguous memory
+/// and range scans walk it sequentially. Recent inserts go to a small sorted
+/// delta array and erased entries are marked as tombstones in place; both
+/// are merged into the main array once they exceed max(64, sqrt(size))
+/// entries, or on compact(). Lookups merge the two arrays on the fly.
+///
+/// Compared with an ordered Boost index, memory per element drops to
+/// sizeof(key) + sizeof(pointer) and reads avoid pointer chasing; inserts
+/// cost O(sqrt(n)) amortized, which suits read-mostly caches.
+///
+/// Used as the storage of lazy_sorted_array in LazyIndexedContainer.
+///
+/// @tparam Value Element type
+/// @tparam KeyFromValue Key extractor over Value (with result_type)
+/// @tparam Compare Strict weak ordering of keys
+/// @tparam Allocator Allocator (rebound to the entry type)
+template <typename Value, typename KeyFromValue, typename Compare = std::less<>,
+          typename Allocator = std::allocator<Value>>
+class SortedArrayIndex {
+public:
+    using key_type = std::remove_cvref_t<typename KeyFromValue::result_type>;
+    using size_type = std::size_t;
+
+    /// Key copy and element; a null element marks an erased entry
+    struct Entry {
+        key_type key;
+        const Value* element;
+    };
+
+    /// @brief Forward iterator over a key range of both arrays, in key order
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = const Value&;
+
+        iterator() = default;
+
+        reference operator*() const { return *current()->element; }
+        pointer operator->() const { return current()->element; }
+
+        iterator& operator++() {
+            if (from_main()) {
+                ++main_;
+                skip_tombstones();
+            } else {
+                ++delta_;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return main_ == other.main_ && delta_ == other.delta_;
+        }
+
+    private:
+        friend class SortedArrayIndex;
+
+        iterator(const Entry* main, const Entry* main_end, const Entry* delta, const Entry* delta_end,
+                 const Compare* compare)
+            : main_(main), main_end_(main_end), delta_(delta), delta_end_(delta_end), compare_(compare)
+        {
+            skip_tombstones();
+        }
+
+        void skip_tombstones() {
+            while (main_ != main_end_ && main_->element == nullptr) {
+                ++main_;
+            }
+        }
+
+        /// Main entries come first among equal keys
+        [[nodiscard]] bool from_main() const {
+            return delta_ == delta_end_ ||
+                (main_ != main_end_ && !(*compare_)(delta_->key, main_->key));
+        }
+
+        [[nodiscard]] const Entry* current() const { return from_main() ? main_ : delta_; }
+
+        const Entry* main_ = nullptr;
+        const Entry* main_end_ = nullptr;
+        const Entry* delta_ = nullptr;
+        const Entry* delta_end_ = nullptr;
+        const Compare* compare_ = nullptr;
+    };
+
+    explicit SortedArrayIndex(Compare compare = Compare())
+        : compare_(std::move(compare))
+    {}
+
+    /// @brief Replace the contents with the given elements
+    template <typename Range>
+    void build(const Range& elements) {
+        main_.clear();
+        delta_.clear();
+        tombstones_ = 0;
+        main_.reserve(elements.size());
+        for (const auto& element : elements) {
+            main_.push_back(Entry{KeyFromValue{}(element), &element});
+        }
+        std::stable_sort(main_.begin(), main_.end(), entry_less());
+    }
+
+    /// @brief Add an element
+    void insert(const Value* element) {
+        Entry entry{KeyFromValue{}(*element), element};
+        delta_.insert(std::upper_bound(delta_.begin(), delta_.end(), entry, entry_less()), std::move(entry));
+        compact_if_needed();
+    }
+
+    /// @brief Remove an element; it must still be alive (its key is read)
+    void erase(const Value* element) {
+        const auto key = KeyFromValue{}(*element);
+        auto [delta_first, delta_last] = std::equal_range(delta_.begin(), delta_.end(), key, key_compare());
+        auto in_delta = std::find_if(delta_first, delta_last, [element](const Entry& entry) {
+            return entry.element == element;
+        });
+        if (in_delta != delta_last) {
+            delta_.erase(in_delta);
+            return;
+        }
+        auto [main_first, main_last] = std::equal_range(main_.begin(), main_.end(), key, key_compare());
+        auto in_main = std::find_if(main_first, main_last, [element](const Entry& entry) {
+            return entry.element == element;
+        });
+        if (in_main != main_last) {
+            in_main->element = nullptr;
+            ++tombstones_;
+            compact_if_needed();
+        }
+    }
+
+    /// @brief Remove all entries
+    void clear() noexcept {
+        main_.clear();
+        delta_.clear();
+        tombstones_ = 0;
+    }
+
+    /// @brief Find an element with given key
+    /// @return Pointer to the element, or nullptr if not found
+    [[nodiscard]] const Value* find(const auto& key) const {
+        auto first = lower_bound(key);
+        return first != end() && !compare_(key, first.current()->key) ? &*first : nullptr;
+    }
+
+    /// @brief Get the first element whose key is not less than key
+    [[nodiscard]] iterator lower_bound(const auto& key) const {
+        return make_iterator(
+            std::lower_bound(main_.begin(), main_.end(), key, key_compare()),
+            std::lower_bound(delta_.begin(), delta_.end(), key, key_compare()));
+    }
+
+    /// @brief Get the first element whose key is greater than key
+    [[nodiscard]] iterator upper_bound(const auto& key) const {
+        return make_iterator(
+            std::upper_bound(main_.begin(), main_.end(), key, key_compare()),
+            std::upper_bound(delta_.begin(), delta_.end(), key, key_compare()));
+    }
+
+    /// @brief Get elements with given key
+    [[nodiscard]] std::pair<iterator, iterator> equal_range(const auto& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /// @brief Get elements with lower <= key < upper
+    [[nodiscard]] std::pair<iterator, iterator> range(const auto& lower, const auto& upper) const {
+        return {lower_bound(lower), lower_bound(upper)};
+    }
+
+    /// @brief Count elements with given key
+    [[nodiscard]] size_type count(const auto& key) const {
+        auto [first, last] = equal_range(key);
+        return static_cast<size_type>(std::distance(first, last));
+    }
+
+    /// @brief Get iterator to the first element in key order
+    [[nodiscard]] iterator begin() const { return make_iterator(main_.begin(), delta_.begin()); }
+
+    /// @brief Get end iterator
+    [[nodiscard]] iterator end() const { return make_iterator(main_.end(), delta_.end()); }
+
+    /// @brief Merge the delta buffer and drop tombstones now
+    void compact() {
+        if (delta_.empty() && tombstones_ == 0) {
+            return;
+        }
+        entries_type merged(main_.get_allocator());
+        merged.reserve(main_.size() - tombstones_ + delta_.size());
+        auto live = [](const Entry& entry) { return entry.element != nullptr; };
+        auto main_it = std::find_if(main_.begin(), main_.end(), live);
+        for (auto& entry : delta_) {
+            while (main_it != main_.end() && !compare_(entry.key, main_it->key)) {
+                merged.push_back(std::move(*main_it));
+                main_it = std::find_if(main_it + 1, main_.end(), live);
+            }
+            merged.push_back(std::move(entry));
+        }
+        for (; main_it != main_.end(); ++main_it) {
+            if (main_it->element != nullptr) {
+                merged.push_back(std::move(*main_it));
+            }
+        }
+        main_.swap(merged);
+        delta_.clear();
+        tombstones_ = 0;
+    }
+
+    /// @brief Get number of indexed elements
+    [[nodiscard]] size_type size() const noexcept { return main_.size() - tombstones_ + delta_.size(); }
+
+    /// @brief Get number of entries waiting in the delta buffer
+    [[nodiscard]] size_type delta_size() const noexcept { return delta_.size(); }
+
+    /// @brief Get number of erased entries still in the main array
+    [[nodiscard]] size_type tombstone_count() const noexcept { return tombstones_; }
+
+    /// @brief Get the bytes of both arrays (heap bytes of key copies are not counted)
+    [[nodiscard]] MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        for (const auto* entries : {&main_, &delta_}) {
+            const auto bytes = entries->capacity() * sizeof(Entry);
+            usage.index_links += bytes;
+            usage.allocator_slack += bytes != 0 ? detail::malloc_slack(bytes) : 0;
+        }
+        return usage;
+    }
+
+private:
+    using entries_type = std::vector<Entry, typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>>;
+
+    static constexpr size_type kMinPending = 64;
+
+    auto entry_less() const {
+        return [this](const Entry& lhs, const Entry& rhs) { return compare_(lhs.key, rhs.key); };
+    }
+
+    /// Comparator usable with lower_bound/upper_bound/equal_range and a bare key
+    struct KeyCompare {
+        const Compare* compare;
+        template <typename K>
+        bool operator()(const Entry& entry, const K& key) const { return (*compare)(entry.key, key); }
+        template <typename K>
+        bool operator()(const K& key, const Entry& entry) const { return (*compare)(key, entry.key); }
+    };
+
+    KeyCompare key_compare() const { return KeyCompare{&compare_}; }
+
+    iterator make_iterator(typename entries_type::const_iterator main, typename entries_type::const_iterator delta) const {
+        const Entry* main_base = main_.data();
+        const Entry* delta_base = delta_.data();
+        return iterator(main_base + (main - main_.begin()), main_base + main_.size(),
+                        delta_base + (delta - delta_.begin()), delta_base + delta_.size(), &compare_);
+    }
+
+    void compact_if_needed() {
+        const auto limit = std::max(kMinPending, static_cast<size_type>(std::sqrt(static_cast<double>(main_.size()))));
+        if (delta_.size() + tombstones_ > limit) {
+            compact();
+        }
+    }
+
+    Compare compare_;
+    entries_type main_;
+    entries_type delta_;
+    size_type tombstones_ = 0;
+};
+
+/// @brief Lazy ordered index kept as a SortedArrayIndex
+/// @tparam Tag Index tag type
+/// @tparam KeyFromValue Key extractor over the value type (with result_type)
+/// @tparam Compare Strict weak ordering of keys
+///
+/// Drop-in replacement for lazy_ordered_non_unique in lazy_indexed_by for
+/// read-mostly caches. To maintain it from the start rather than on first
+/// query, call build_index<Tag>() after construction.
+template <typename Tag, typename KeyFromValue, typename Compare = std::less<>>
+struct lazy_sorted_array {
+    using tag_type = Tag;
+    using key_from_value_type = KeyFromValue;
+
+    template <typename Value, typename Allocator>
+    using storage_type = SortedArrayIndex<Value, KeyFromValue, Compare, Allocator>;
+};
+
+}  // namespace multi_index_lru
@@ -26,11 +26,14 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -79,6 +82,22 @@ struct timestamped_key {
     }
 };
 
+namespace detail {
+
+/// Whether a key extractor may read the given top-level field
+template <typename Extractor>
+bool extractor_reads_field(const Extractor& extractor, std::string_view name) {
+    if constexpr (requires { { extractor.name } -> std::convertible_to<std::string_view>; }) {
+        return extractor.name == name;
+    } else if constexpr (requires { extractor.path.front(); }) {
+        return extractor.path.empty() || extractor.path.front() == name;
+    } else {
+        return true;
+    }
+}
+
+}  // namespace detail
+
 /// @brief Builder for creating ZerializeEntry from deserializer
 /// @tparam Entry The ZerializeEntry type
 /// @tparam Extractors Pack of field extractor functions
@@ -95,23 +114,42 @@ public:
     template <ZerializeDeserializer Deserializer>
     Entry build(std::span<const uint8_t> data) const {
         Deserializer reader(data);
-        return build_impl(reader, data, std::index_sequence_for<Extractors...>{});
+        return Entry(extract_keys(reader), data);
     }
 
     /// @brief Build entry from existing deserializer + data
     template <ZerializeDeserializer Deserializer>
     Entry build(const Deserializer& reader, std::span<const uint8_t> data) const {
-        return build_impl(reader, data, std::index_sequence_for<Extractors...>{});
+        return Entry(extract_keys(reader), data);
+    }
+
+    /// @brief Extract keys from raw data using deserializer
+    template <ZerializeDeserializer Deserializer>
+    keys_type extract_keys(std::span<const uint8_t> data) const {
+        return extract_keys(Deserializer(data));
+    }
+
+    /// @brief Extract keys from an existing deserializer
+    template <ZerializeDeserializer Deserializer>
+    keys_type extract_keys(const Deserializer& reader) const {
+        return extract_impl(reader, std::index_sequence_for<Extractors...>{});
+    }
+
+    /// @brief Check whether any key is read from a top-level field
+    /// @param name Top-level field name
+    ///
+    /// Exact for field and nested_field extractors; any other extractor is
+    /// assumed to read every field.
+    [[nodiscard]] bool reads_field(std::string_view name) const {
+        return std::apply([name](const auto&... extractors) {
+            return (detail::extractor_reads_field(extractors, name) || ...);
+        }, extractors_);
     }
 
 private:
     template <typename Deserializer, std::size_t... Is>
-    Entry build_impl(const Deserializer& reader, std::span<const uint8_t> data,
-                     std::index_sequence<Is...>) const {
-        return Entry(
-            keys_type(std::get<Is>(extractors_)(reader)...),
-            data
-        );
+    keys_type extract_impl(const Deserializer& reader, std::index_sequence<Is...>) const {
+        return keys_type(std::get<Is>(extractors_)(reader)...);
     }
 
     std::tuple<Extractors...> extractors_;
@@ -199,4 +237,69 @@ struct nested_field {
     }
 };
 
+/// @brief Outcome of patch_entry()
+enum class PatchResult {
+    not_found,  ///< No entry with the key (or it expired)
+    patched,    ///< Payload patched, index keys unchanged
+    rekeyed,    ///< Payload patched and the entry was re-indexed under new keys
+    erased      ///< New keys collided with another entry; the patched entry was removed
+};
+
+/// @brief Apply a partial update to the serialized bytes of a cached entry
+/// @tparam Tag Index tag used to find the entry
+/// @tparam Deserializer zerialize deserializer type used to re-extract keys
+/// @param cache Container or ExpirableContainer of ZerializeEntry values
+/// @param key Key of the entry to patch
+/// @param builder EntryBuilder that built the entry
+/// @param touched_fields Top-level fields the patch writes
+/// @param patch Called as patch(std::vector<uint8_t>&) on the owned bytes
+/// @return What happened to the entry
+///
+/// The patch edits the stored document directly: overwrite a fixed-width
+/// value in place where the format allows it (MsgPack/CBOR float64 or
+/// int64, FlexBuffers scalars, ZERA fixed fields), or splice a re-encoded
+/// field into the buffer. The rest of the document is neither re-serialized
+/// nor copied, and the entry is not reinserted.
+///
+/// Keys are re-extracted only if the builder reads one of touched_fields;
+/// if they changed, the entry is re-indexed. The entry moves to the front of
+/// the LRU list (and its timestamp is refreshed for ExpirableContainer).
+///
+/// Example usage:
+/// @code
+/// // score is stored as a MsgPack float64 at a known offset
+/// auto result = multi_index_lru::patch_entry<IdTag, zerialize::MsgPackDeserializer>(
+///     cache, id, builder, {"score"}, [&](std::vector<uint8_t>& bytes) {
+///         write_big_endian(bytes.data() + score_offset, new_score);
+///     });
+/// @endcode
+template <typename Tag, ZerializeDeserializer Deserializer, typename Cache, typename Builder, typename Patch>
+    requires std::invocable<Patch&, std::vector<uint8_t>&>
+PatchResult patch_entry(Cache& cache, const auto& key, const Builder& builder,
+                        std::initializer_list<std::string_view> touched_fields, Patch&& patch) {
+    const bool touches_keys = std::any_of(touched_fields.begin(), touched_fields.end(),
+        [&builder](std::string_view name) { return builder.reads_field(name); });
+    bool visited = false;
+    bool rekeyed = false;
+    const bool present = cache.template modify<Tag>(key, [&](auto& entry) {
+        visited = true;
+        patch(entry.data);
+        if (!touches_keys) {
+            return;
+        }
+        auto keys = builder.template extract_keys<Deserializer>(entry.raw_data());
+        if (keys != entry.keys) {
+            entry.keys = std::move(keys);
+            rekeyed = true;
+        }
+    });
+    if (!visited) {
+        return PatchResult::not_found;
+    }
+    if (!present) {
+        return PatchResult::erased;
+    }
+    return rekeyed ? PatchResult::rekeyed : PatchResult::patched;
+}
+
 }  // namespace multi_index_lru
@@ -17,6 +17,9 @@
 /// @file multi_index_lru/zerialize_entry.hpp
 /// @brief Entry wrapper for zerialize data with extracted keys
 
+#include <multi_index_lru/memory_usage.hpp>
+
+#include <cstddef>
 #include <cstdint>
 #include <span>
 #include <string>
@@ -63,6 +66,11 @@ struct ZerializeEntry {
     [[nodiscard]] std::span<const uint8_t> raw_data() const noexcept {
         return std::span<const uint8_t>(data);
     }
+
+    /// @brief Heap bytes of the owned buffer and keys, for memory_usage() accounting
+    friend std::size_t heap_bytes(const ZerializeEntry& entry) {
+        return multi_index_lru::heap_bytes(entry.data) + detail::tuple_payload_bytes(entry.keys);
+    }
 };
 
 /// @brief Helper to define ZerializeEntry with explicit key types
@@ -0,0 +1,190 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/bulk_load.hpp>
+#include <multi_index_lru/sbe_cache.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct MockSbeView {
+    std::span<const uint8_t> bytes;
+
+    std::uint16_t template_id() const {
+        return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8U));
+    }
+
+    std::uint32_t security_id() const {
+        return static_cast<std::uint32_t>(bytes[2]) |
+               (static_cast<std::uint32_t>(bytes[3]) << 8U) |
+               (static_cast<std::uint32_t>(bytes[4]) << 16U) |
+               (static_cast<std::uint32_t>(bytes[5]) << 24U);
+    }
+};
+
+std::vector<uint8_t> MakePayload(std::uint16_t template_id, std::uint32_t security_id) {
+    return {
+        static_cast<uint8_t>(template_id & 0xFFU),
+        static_cast<uint8_t>(template_id >> 8U),
+        static_cast<uint8_t>(security_id & 0xFFU),
+        static_cast<uint8_t>((security_id >> 8U) & 0xFFU),
+        static_cast<uint8_t>((security_id >> 16U) & 0xFFU),
+        static_cast<uint8_t>((security_id >> 24U) & 0xFFU),
+    };
+}
+
+struct SecurityTag {};
+struct TemplateTag {};
+
+using Entry = multi_index_lru::SbeEntryWithKeys_t<std::uint32_t, std::uint16_t>;
+
+using QuoteCache = multi_index_lru::ShardedContainer<
+    Entry,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<SecurityTag>,
+            multi_index_lru::sbe_key<0, Entry>>,
+        boost::multi_index::ordered_non_unique<
+            boost::multi_index::tag<TemplateTag>,
+            multi_index_lru::sbe_key<1, Entry>>>>;
+
+auto MakeBuilder() {
+    return multi_index_lru::make_sbe_entry_builder<Entry>(
+        [](std::span<const uint8_t> bytes) { return MockSbeView{bytes}; },
+        multi_index_lru::make_sbe_field<std::uint32_t>(&MockSbeView::security_id),
+        multi_index_lru::make_sbe_field<std::uint16_t>(&MockSbeView::template_id));
+}
+
+std::vector<std::uint32_t> LruOrder(QuoteCache& cache, std::size_t shard) {
+    return cache.with_shard(shard, [](const auto& c) {
+        std::vector<std::uint32_t> order;
+        for (const auto& entry : c) {
+            order.push_back(std::get<0>(entry.keys));
+        }
+        return order;
+    });
+}
+
+TEST(BulkLoadTest, MatchesSequentialInsert) {
+    // Duplicates and more inputs than capacity exercise refresh and eviction
+    std::vector<std::vector<uint8_t>> payloads;
+    for (std::uint32_t i = 0; i < 5000; ++i) {
+        payloads.push_back(MakePayload(static_cast<std::uint16_t>(i % 7), (i * 7919U) % 3000U));
+    }
+    std::vector<std::span<const uint8_t>> inputs(payloads.begin(), payloads.end());
+    const auto builder = MakeBuilder();
+
+    QuoteCache sequential(2000, 8);
+    std::size_t sequential_inserted = 0;
+    for (auto input : inputs) {
+        sequential_inserted += sequential.insert(builder.build(input)) ? 1 : 0;
+    }
+
+    QuoteCache parallel(2000, 8);
+    const auto inserted = multi_index_lru::bulk_load(
+        parallel, inputs, [&builder](std::span<const uint8_t> bytes) { return builder.build(bytes); },
+        {.threads = 4, .chunk_size = 97});
+
+    EXPECT_EQ(inserted, sequential_inserted);
+    EXPECT_EQ(parallel.size(), sequential.size());
+    for (std::size_t shard = 0; shard < parallel.shard_count(); ++shard) {
+        EXPECT_EQ(LruOrder(parallel, shard), LruOrder(sequential, shard));
+    }
+    auto hit = parallel.find_no_update<SecurityTag>(std::uint32_t{(4999U * 7919U) % 3000U});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->raw_data().size(), 6U);
+}
+
+TEST(BulkLoadTest, ConcurrentReshardKeepsEveryElementReachable) {
+    std::vector<std::vector<uint8_t>> payloads;
+    for (std::uint32_t i = 0; i < 20000; ++i) {
+        payloads.push_back(MakePayload(0, i));
+    }
+    std::vector<std::span<const uint8_t>> inputs(payloads.begin(), payloads.end());
+    const auto builder = MakeBuilder();
+
+    QuoteCache cache(40000, 4);
+    for (std::uint32_t i = 20000; i < 21000; ++i) {
+        cache.insert(builder.build(MakePayload(0, i)));
+    }
+    cache.reshard(3);  // leave a migration in progress
+
+    std::atomic<bool> done{false};
+    std::thread resharder([&cache, &done] {
+        for (std::size_t shards = 2; !done.load(); shards = shards % 7 + 2) {
+            cache.reshard(shards);
+        }
+    });
+    std::size_t inserted = 0;
+    for (int round = 0; round < 5; ++round) {
+        inserted += multi_index_lru::bulk_load(
+            cache, inputs, [&builder](std::span<const uint8_t> bytes) { return builder.build(bytes); },
+            {.threads = 4, .chunk_size = 512});
+    }
+    done.store(true);
+    resharder.join();
+    cache.finish_migration();
+
+    EXPECT_EQ(inserted, 20000U);
+    EXPECT_EQ(cache.size(), 21000U);
+    for (std::uint32_t i = 0; i < 21000; ++i) {
+        ASSERT_TRUE(cache.contains_no_update<SecurityTag>(i)) << i;
+    }
+}
+
+TEST(BulkLoadTest, BuildExceptionPropagates) {
+    std::vector<int> inputs(1000);
+    for (int i = 0; i < 1000; ++i) {
+        inputs[static_cast<std::size_t>(i)] = i;
+    }
+    QuoteCache cache(2000, 4);
+    std::atomic<int> built{0};
+
+    EXPECT_THROW(multi_index_lru::bulk_load(cache, inputs, [&built](int i) {
+        if (i == 500) {
+            throw std::runtime_error("corrupt message");
+        }
+        built.fetch_add(1);
+        return Entry({static_cast<std::uint32_t>(i), std::uint16_t{0}}, std::vector<uint8_t>{});
+    }, {.threads = 3, .chunk_size = 10}), std::runtime_error);
+
+    EXPECT_LT(built.load(), 1000);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_THROW(multi_index_lru::bulk_load(cache, inputs, [](int) { return Entry(); }, {.chunk_size = 0}),
+                 std::invalid_argument);
+}
+
+TEST(BulkLoadTest, WorkStealingRunsEveryTaskOnce) {
+    std::vector<std::atomic<int>> runs(257);
+    multi_index_lru::detail::run_work_stealing(runs.size(), 4, [&runs](std::size_t, std::size_t task) {
+        runs[task].fetch_add(1);
+    });
+    for (const auto& count : runs) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+}  // namespace
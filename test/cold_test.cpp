@@ -0,0 +1,76 @@
+#include <multi_index_lru/cold.hpp>
+#include <multi_index_lru/expirable_container.hpp>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+
+namespace {
+
+struct IdTag {};
+
+struct Details {
+    std::string description;
+    std::vector<int> legs;
+
+    bool operator==(const Details&) const = default;
+};
+
+struct Order {
+    int id;
+    multi_index_lru::cold<Details> details;
+};
+
+struct IdKey {
+    using result_type = int;
+    template <typename Wrapped>
+    result_type operator()(const Wrapped& wrapped) const { return wrapped.value.id; }
+};
+
+TEST(ColdTest, ValueSemantics) {
+    multi_index_lru::cold<Details> original(Details{"spread", {1, 2}});
+    auto copy = original;
+    copy->legs.push_back(3);
+    EXPECT_EQ(original->legs.size(), 2U);
+    EXPECT_FALSE(copy == original);
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(moved->legs.size(), 3U);
+
+    copy = original;
+    EXPECT_TRUE(copy == original);
+
+    multi_index_lru::cold<Details> in_place(std::in_place, "outright", std::vector<int>{4});
+    EXPECT_EQ(in_place.get().description, "outright");
+    EXPECT_TRUE(multi_index_lru::cold<Details>()->legs.empty());
+}
+
+TEST(ColdTest, WorksInsideCacheValues) {
+    multi_index_lru::ExpirableContainer<
+        Order,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<boost::multi_index::tag<IdTag>, IdKey>>>
+        cache(2, std::chrono::hours(1));
+
+    cache.emplace(Order{1, Details{"a", {1}}});
+    const auto* payload = &cache.find<IdTag>(1)->details.get();
+    cache.emplace(Order{2, Details{"b", {2}}});
+
+    auto it = cache.find<IdTag>(1);
+    ASSERT_NE(it, cache.end<IdTag>());
+    EXPECT_EQ(it->details->description, "a");
+    EXPECT_EQ(&it->details.get(), payload);  // payload not moved by container operations
+}
+
+TEST(ColdTest, TimestampLeadsTheNode) {
+    multi_index_lru::detail::TimestampedValue<Order> item(Order{1, Details{}});
+    EXPECT_EQ(static_cast<const void*>(&item.last_accessed), static_cast<const void*>(&item));
+    EXPECT_LT(reinterpret_cast<const char*>(&item.value) - reinterpret_cast<const char*>(&item), 64);
+}
+
+}  // namespace
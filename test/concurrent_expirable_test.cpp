@@ -0,0 +1,206 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/concurrent_expirable_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct SessionTag {};
+struct UserTag {};
+
+struct Session {
+    std::string id;
+    int user_id;
+};
+
+struct SessionIdExtractor {
+    using result_type = std::string;
+    template <typename T>
+    result_type operator()(const T& wrapped) const { return wrapped.value.id; }
+};
+
+struct UserIdExtractor {
+    using result_type = int;
+    template <typename T>
+    result_type operator()(const T& wrapped) const { return wrapped.value.user_id; }
+};
+
+using SessionStore = multi_index_lru::ConcurrentExpirableContainer<
+    Session,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<SessionTag>,
+            SessionIdExtractor>,
+        boost::multi_index::ordered_non_unique<
+            boost::multi_index::tag<UserTag>,
+            UserIdExtractor>>>;
+
+TEST(ConcurrentExpirableTest, BasicOperations) {
+    SessionStore store(100, 1h, 4);
+    EXPECT_EQ(store.touch_threshold(), std::chrono::milliseconds(1h) / 16);
+
+    EXPECT_TRUE(store.insert(Session{"s1", 1}));
+    EXPECT_TRUE(store.insert(Session{"s2", 2}));
+    EXPECT_FALSE(store.insert(Session{"s1", 1}));
+    EXPECT_EQ(store.size(), 2U);
+
+    auto hit = store.find<SessionTag>(std::string("s1"));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->user_id, 1);
+
+    // Secondary index lookups visit every shard
+    auto by_user = store.find<UserTag>(2);
+    ASSERT_TRUE(by_user.has_value());
+    EXPECT_EQ(by_user->id, "s2");
+
+    EXPECT_TRUE(store.erase<SessionTag>(std::string("s1")));
+    EXPECT_FALSE(store.contains<SessionTag>(std::string("s1")));
+    EXPECT_TRUE(store.contains_no_update<UserTag>(2));
+
+    store.clear();
+    EXPECT_TRUE(store.empty());
+}
+
+TEST(ConcurrentExpirableTest, ItemsExpire) {
+    SessionStore store(100, 50ms, 2);
+    store.insert(Session{"s1", 1});
+    EXPECT_TRUE(store.contains<SessionTag>(std::string("s1")));
+
+    std::this_thread::sleep_for(70ms);
+
+    // find_no_update does not check TTL
+    EXPECT_TRUE(store.find_no_update<SessionTag>(std::string("s1")).has_value());
+    // find does, and erases the expired element
+    EXPECT_FALSE(store.find<SessionTag>(std::string("s1")).has_value());
+    EXPECT_EQ(store.size(), 0U);
+}
+
+TEST(ConcurrentExpirableTest, HitsBelowThresholdDoNotRefresh) {
+    SessionStore store(100, 100ms, 1);
+    store.set_touch_threshold(1h);  // never rewrite the timestamp on hits
+
+    store.insert(Session{"s1", 1});
+    std::this_thread::sleep_for(60ms);
+    EXPECT_TRUE(store.contains<SessionTag>(std::string("s1")));
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(store.contains<SessionTag>(std::string("s1")));
+}
+
+TEST(ConcurrentExpirableTest, HitsAboveThresholdRefresh) {
+    SessionStore store(100, 100ms, 1);
+    store.set_touch_threshold(0ms);
+
+    store.insert(Session{"s1", 1});
+    std::this_thread::sleep_for(60ms);
+    EXPECT_TRUE(store.contains<SessionTag>(std::string("s1")));
+    std::this_thread::sleep_for(60ms);
+    EXPECT_TRUE(store.contains<SessionTag>(std::string("s1")));
+}
+
+TEST(ConcurrentExpirableTest, DeferredLruReorderingIsAppliedByWriters) {
+    SessionStore store(3, 1h, 1);
+    store.insert(Session{"s1", 1});
+    store.insert(Session{"s2", 2});
+    store.insert(Session{"s3", 3});
+
+    // The hit is buffered and replayed by the next insert before it evicts
+    EXPECT_TRUE(store.contains<SessionTag>(std::string("s1")));
+    store.insert(Session{"s4", 4});
+
+    EXPECT_TRUE(store.contains_no_update<SessionTag>(std::string("s1")));
+    EXPECT_FALSE(store.contains_no_update<SessionTag>(std::string("s2")));
+    EXPECT_TRUE(store.contains_no_update<SessionTag>(std::string("s3")));
+    EXPECT_TRUE(store.contains_no_update<SessionTag>(std::string("s4")));
+}
+
+TEST(ConcurrentExpirableTest, CleanupExpired) {
+    SessionStore store(100, 50ms, 4);
+    for (int i = 0; i < 20; ++i) {
+        store.insert(Session{std::to_string(i), i});
+    }
+    std::this_thread::sleep_for(70ms);
+    store.cleanup_expired();
+    EXPECT_EQ(store.size(), 0U);
+}
+
+TEST(ConcurrentExpirableTest, UnevenCapacityAddsUpToTheTotal) {
+    SessionStore store(10, 1h, 4);
+    for (int i = 0; i < 1000; ++i) {
+        store.insert(Session{std::to_string(i), i});
+    }
+    EXPECT_EQ(store.size(), 10U);
+
+    store.set_capacity(7);
+    EXPECT_EQ(store.size(), 7U);
+}
+
+TEST(ConcurrentExpirableTest, ParameterValidation) {
+    EXPECT_THROW((SessionStore{0, 1h, 1}), std::invalid_argument);
+    EXPECT_THROW((SessionStore{10, 0ms, 1}), std::invalid_argument);
+    EXPECT_THROW((SessionStore{10, 1h, 0}), std::invalid_argument);
+
+    SessionStore store(10, 1h, 2);
+    EXPECT_THROW(store.set_capacity(0), std::invalid_argument);
+    EXPECT_THROW(store.set_ttl(0ms), std::invalid_argument);
+    EXPECT_THROW(store.set_touch_threshold(-1ms), std::invalid_argument);
+}
+
+TEST(ConcurrentExpirableTest, ConcurrentReadersAndWriter) {
+    SessionStore store(1000, 1h, 4);
+    for (int i = 0; i < 100; ++i) {
+        store.insert(Session{std::to_string(i), i});
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                for (int i = 0; i < 100; ++i) {
+                    if (!store.contains<SessionTag>(std::to_string(i))) {
+                        misses.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 100; i < 600; ++i) {
+        store.insert(Session{std::to_string(i), i});
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_EQ(store.size(), 600U);
+}
+
+}  // namespace
@@ -154,6 +154,73 @@ TEST_F(LRUUsersTest, ContainsNoUpdateDoesNotRefreshLru) {
     EXPECT_TRUE(cache.contains_no_update<IdTag>(3));
 }
 
+TEST_F(LRUUsersTest, ModifyInPlaceRefreshesLru) {
+    UserCache cache(2);
+    cache.emplace(User{1, "a@test.com", "A"});
+    cache.emplace(User{2, "b@test.com", "B"});
+
+    EXPECT_TRUE(cache.modify<IdTag>(1, [](User& user) { user.name = "Anna"; }));
+    EXPECT_FALSE(cache.modify<IdTag>(999, [](User&) {}));
+    ASSERT_TRUE(cache.contains_no_update<NameTag>(std::string("Anna")));
+    EXPECT_FALSE(cache.contains_no_update<NameTag>(std::string("A")));
+
+    // id=1 was moved to front, so id=2 is evicted
+    cache.emplace(User{3, "c@test.com", "C"});
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(1));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(2));
+
+    // A key collision on a unique index removes the modified element
+    EXPECT_FALSE(cache.modify<IdTag>(1, [](User& user) { user.email = "c@test.com"; }));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(1));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(LRUUsersTest, ModifyThroughIteratorOfAnyIndex) {
+    UserCache cache(2);
+    cache.emplace(User{1, "a@test.com", "A"});
+    cache.emplace(User{2, "b@test.com", "B"});
+
+    auto it = cache.find_no_update<EmailTag>(std::string("a@test.com"));
+    EXPECT_TRUE(cache.modify(it, [](User& user) { user.name = "Anna"; }));
+    EXPECT_EQ(it->name, "Anna");
+    EXPECT_EQ(cache.get_sequenced().front().id, 1);
+
+    EXPECT_FALSE(cache.modify(it, [](User& user) { user.id = 2; }));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(LRUUsersTest, ExtractAndInsertNodeHandles) {
+    UserCache probation(3);
+    UserCache main(2);
+    probation.emplace(User{1, "a@test.com", "A"});
+    probation.emplace(User{2, "b@test.com", "B"});
+    const auto* element = &*probation.find_no_update<IdTag>(1);
+
+    EXPECT_TRUE(probation.extract<IdTag>(999).empty());
+    auto node = probation.extract<EmailTag>(std::string("a@test.com"));
+    ASSERT_FALSE(node.empty());
+    EXPECT_EQ(node.value().name, "A");
+    EXPECT_FALSE(probation.contains_no_update<IdTag>(1));
+
+    EXPECT_TRUE(main.insert(std::move(node)));
+    EXPECT_TRUE(node.empty());
+    EXPECT_EQ(&*main.find_no_update<IdTag>(1), element);  // same node, no copy
+    EXPECT_FALSE(main.insert(UserCache::node_type()));
+
+    // Collision: existing element refreshed, node keeps its element
+    main.emplace(User{3, "c@test.com", "C"});
+    probation.emplace(User{3, "c@test.com", "Other"});
+    auto duplicate = probation.extract<IdTag>(3);
+    EXPECT_FALSE(main.insert(std::move(duplicate)));
+    ASSERT_FALSE(duplicate.empty());
+    EXPECT_EQ(duplicate.value().name, "Other");
+
+    // Inserting past capacity evicts the LRU element
+    EXPECT_TRUE(main.insert(probation.extract<IdTag>(2)));
+    EXPECT_EQ(main.size(), 2);
+    EXPECT_FALSE(main.contains_no_update<IdTag>(1));
+}
+
 class ProductsTest : public ::testing::Test {
 protected:
     struct SkuTag {};
@@ -242,6 +309,76 @@ TEST(HashedIndexTest, SimpleUsage) {
     EXPECT_NE(it, cache.end<MyTag>());
 }
 
+TEST(HashedIndexTest, ReserveBucketsAtConstruction) {
+    struct Item {
+        int id;
+        std::string name;
+    };
+
+    struct IdTag {};
+    struct NameTag {};
+
+    using Cache = multi_index_lru::Container<
+        Item,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                boost::multi_index::member<Item, int, &Item::id>>,
+            boost::multi_index::hashed_non_unique<
+                boost::multi_index::tag<NameTag>,
+                boost::multi_index::member<Item, std::string, &Item::name>>>>;
+
+    Cache cache(1000, true);
+    const auto id_buckets = cache.get_index<IdTag>().bucket_count();
+    const auto name_buckets = cache.get_index<NameTag>().bucket_count();
+    EXPECT_GE(id_buckets, 1000U);
+    EXPECT_GE(name_buckets, 1000U);
+
+    // Filling up to capacity must not trigger a rehash
+    for (int i = 0; i < 1000; ++i) {
+        cache.emplace(Item{i, std::to_string(i)});
+    }
+    EXPECT_EQ(cache.get_index<IdTag>().bucket_count(), id_buckets);
+    EXPECT_EQ(cache.get_index<NameTag>().bucket_count(), name_buckets);
+
+    // Growing the capacity grows the buckets ahead of the inserts
+    cache.set_capacity(4000);
+    EXPECT_GE(cache.get_index<IdTag>().bucket_count(), 4000U);
+    EXPECT_GE(cache.get_index<NameTag>().bucket_count(), 4000U);
+}
+
+TEST(HashedIndexTest, ReserveAndMaxLoadFactorPropagate) {
+    struct Item {
+        int id;
+        std::string name;
+    };
+
+    struct IdTag {};
+    struct NameTag {};
+
+    using Cache = multi_index_lru::Container<
+        Item,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                boost::multi_index::member<Item, int, &Item::id>>,
+            boost::multi_index::ordered_non_unique<
+                boost::multi_index::tag<NameTag>,
+                boost::multi_index::member<Item, std::string, &Item::name>>>>;
+
+    Cache cache(100);
+    EXPECT_FLOAT_EQ(cache.max_load_factor(), 1.0f);
+
+    cache.max_load_factor(0.5f);
+    EXPECT_FLOAT_EQ(cache.max_load_factor(), 0.5f);
+    EXPECT_FLOAT_EQ(cache.get_index<IdTag>().max_load_factor(), 0.5f);
+
+    cache.reserve(500);
+    EXPECT_GE(cache.get_index<IdTag>().bucket_count(), 1000U);
+
+    EXPECT_THROW(cache.max_load_factor(0.0f), std::invalid_argument);
+}
+
 TEST(IterationTest, IterateInLRUOrder) {
     struct Item {
         int id;
@@ -22,10 +22,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <utility>
 
 using namespace std::chrono_literals;
 
@@ -181,6 +184,28 @@ TEST_F(ExpirableBasicTest, ParameterValidation) {
     EXPECT_THROW(cache.set_ttl(0ms), std::invalid_argument);
 }
 
+TEST(ExpirableReserveTest, ReserveBucketsAtConstruction) {
+    using HashedCache = multi_index_lru::ExpirableContainer<
+        ExpirableUserValue,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                IdExtractor<multi_index_lru::detail::TimestampedValue<ExpirableUserValue>>>>>;
+
+    HashedCache cache(256, 1h, true);
+    EXPECT_FLOAT_EQ(cache.max_load_factor(), 1.0f);
+
+    for (int i = 0; i < 256; ++i) {
+        cache.insert(ExpirableUserValue{i, "", ""});
+    }
+    EXPECT_EQ(cache.size(), 256);
+    EXPECT_NE(cache.find<IdTag>(255), cache.end<IdTag>());
+
+    cache.reserve(1024);
+    cache.max_load_factor(0.75f);
+    EXPECT_FLOAT_EQ(cache.max_load_factor(), 0.75f);
+}
+
 // =============================================================================
 // TTL Expiration Tests
 // =============================================================================
@@ -227,6 +252,106 @@ TEST(ExpirableTTLTest, AccessRefreshesTTL) {
     EXPECT_EQ(cache.find<IdTag>(1), cache.end<IdTag>());
 }
 
+TEST(ExpirableTTLTest, ExtractInsertKeepsTimestamp) {
+    EasierUserCache probation(10, 1h);
+    EasierUserCache main(10, 1h);
+    probation.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    const auto stamp = probation.find_no_update<IdTag>(1).base()->last_accessed;
+    const auto* element = &*probation.find_no_update<IdTag>(1);
+
+    auto node = probation.extract<IdTag>(1);
+    ASSERT_FALSE(node.empty());
+    EXPECT_TRUE(probation.empty());
+    EXPECT_TRUE(probation.extract<IdTag>(1).empty());
+    EXPECT_EQ(node.value().value.name, "Alice");
+
+    EXPECT_TRUE(main.insert(std::move(node)));
+    EXPECT_TRUE(node.empty());
+    auto it = main.find_no_update<IdTag>(1);
+    ASSERT_NE(it, main.end<IdTag>());
+    EXPECT_EQ(&*it, element);  // same node, no copy
+    EXPECT_EQ(it.base()->last_accessed, stamp);
+
+    // Expired elements are removed rather than extracted
+    EasierUserCache short_lived(10, 20ms);
+    short_lived.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    std::this_thread::sleep_for(40ms);
+    EXPECT_TRUE(short_lived.extract<IdTag>(2).empty());
+    EXPECT_EQ(short_lived.size(), 0);
+}
+
+TEST(ExpirableTTLTest, ExtractInsertKeepsLruOrderedByTimestamp) {
+    EasierUserCache probation(10, 1h);
+    EasierUserCache main(10, 1h);
+    probation.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    std::this_thread::sleep_for(2ms);
+    main.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    std::this_thread::sleep_for(2ms);
+    probation.insert(ExpirableUserValue{5, "erin@test.com", "Erin"});
+    std::this_thread::sleep_for(2ms);
+    main.insert(ExpirableUserValue{3, "carol@test.com", "Carol"});
+    probation.insert(ExpirableUserValue{4, "dave@test.com", "Dave"});
+
+    // Older than everything in main: goes to the LRU tail
+    const auto stamp = probation.find_no_update<IdTag>(1).base()->last_accessed;
+    EXPECT_TRUE(main.insert(probation.extract<IdTag>(1)));
+    EXPECT_EQ(main.lru_last_accessed(), stamp);
+
+    // Newer than everything in main: goes to the front
+    EXPECT_TRUE(main.insert(probation.extract<IdTag>(4)));
+
+    // In between: goes behind the newer element only
+    EXPECT_TRUE(main.insert(probation.extract<IdTag>(5)));
+    EXPECT_TRUE(main.evict_lru());
+    EXPECT_FALSE(main.contains_no_update<IdTag>(1));
+    EXPECT_TRUE(main.evict_lru());
+    EXPECT_FALSE(main.contains_no_update<IdTag>(2));
+    EXPECT_TRUE(main.evict_lru());
+    EXPECT_FALSE(main.contains_no_update<IdTag>(5));
+    EXPECT_TRUE(main.evict_lru());
+    EXPECT_FALSE(main.contains_no_update<IdTag>(3));
+    EXPECT_TRUE(main.contains_no_update<IdTag>(4));
+}
+
+TEST(ExpirableTTLTest, ExtractInsertRefusesElementsPastTheTtl) {
+    EasierUserCache probation(10, 1h);
+    EasierUserCache main(10, 20ms);
+    probation.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    std::this_thread::sleep_for(60ms);
+
+    auto node = probation.extract<IdTag>(1);
+    ASSERT_FALSE(node.empty());
+    EXPECT_FALSE(main.insert(std::move(node)));
+    EXPECT_FALSE(node.empty());
+    EXPECT_TRUE(main.empty());
+
+    // Within a stale window the element is still accepted
+    main.set_stale_policy({.stale_while_revalidate = 1h, .stale_if_error = 0ms});
+    EXPECT_TRUE(main.insert(std::move(node)));
+    EXPECT_TRUE(main.find_allow_stale<IdTag>(1).stale());
+}
+
+TEST(ExpirableTTLTest, ExtractInsertCollisionRefreshesExisting) {
+    EasierUserCache source(10, 1h);
+    EasierUserCache main(10, 1h);
+    main.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    main.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    source.insert(ExpirableUserValue{1, "alice@test.com", "Alice v2"});
+    const auto stamp = main.find_no_update<IdTag>(1).base()->last_accessed;
+    std::this_thread::sleep_for(2ms);
+
+    auto node = source.extract<IdTag>(1);
+    EXPECT_FALSE(main.insert(std::move(node)));
+    EXPECT_FALSE(node.empty());
+    EXPECT_GT(main.find_no_update<IdTag>(1).base()->last_accessed, stamp);
+    EXPECT_EQ(main.find_no_update<IdTag>(1)->name, "Alice");
+
+    // Moved to the front: 2 is now least recently used
+    EXPECT_TRUE(main.evict_lru());
+    EXPECT_TRUE(main.contains_no_update<IdTag>(1));
+    EXPECT_FALSE(main.contains_no_update<IdTag>(2));
+}
+
 TEST(ExpirableTTLTest, FindNoUpdateDoesNotRefresh) {
     EasierUserCache cache(100, 80ms);
     
@@ -358,6 +483,584 @@ TEST(ExpirableEqualRangeTest, EqualRangeNoUpdateConstOverload) {
     EXPECT_EQ(count, 2);
 }
 
+// =============================================================================
+// Stale-while-revalidate / stale-if-error
+// =============================================================================
+
+TEST(ExpirableStaleTest, StaleWhileRevalidate) {
+    EasierUserCache cache(10, 40ms);
+    cache.set_stale_policy({.stale_while_revalidate = 1h});
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+
+    auto hit = cache.find_allow_stale<IdTag>(1);
+    EXPECT_EQ(hit.freshness, multi_index_lru::Freshness::fresh);
+    EXPECT_EQ(hit.iterator->name, "Alice");
+
+    std::this_thread::sleep_for(60ms);
+    // find() treats the element as expired but keeps it for stale reads
+    EXPECT_EQ(cache.find<IdTag>(1), cache.end<IdTag>());
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.size(), 1);
+
+    auto stale = cache.find_allow_stale<IdTag>(1);
+    ASSERT_TRUE(stale.found());
+    EXPECT_TRUE(stale.stale());
+    EXPECT_EQ(stale.iterator->name, "Alice");
+    // Stale hits do not refresh the timestamp
+    EXPECT_TRUE(cache.find_allow_stale<IdTag>(1).stale());
+
+    // The refresh lands: the element is fresh again
+    EXPECT_FALSE(cache.insert_or_assign(ExpirableUserValue{1, "alice@test.com", "Alice v2"}));
+    auto refreshed = cache.find_allow_stale<IdTag>(1);
+    EXPECT_EQ(refreshed.freshness, multi_index_lru::Freshness::fresh);
+    EXPECT_EQ(refreshed.iterator->name, "Alice v2");
+
+    auto missing = cache.find_allow_stale<IdTag>(2);
+    EXPECT_FALSE(missing.found());
+    EXPECT_EQ(missing.iterator, cache.end<IdTag>());
+}
+
+TEST(ExpirableStaleTest, StaleWindowEnds) {
+    EasierUserCache cache(10, 20ms);
+    cache.set_stale_policy({.stale_while_revalidate = 20ms});
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(cache.find_allow_stale<IdTag>(1).found());
+    EXPECT_EQ(cache.size(), 0);  // removed once past both windows
+}
+
+TEST(ExpirableStaleTest, GetOrLoad) {
+    EasierUserCache cache(10, 40ms);
+    cache.set_stale_policy({.stale_if_error = 1h});
+    int loads = 0;
+    auto load = [&loads](int id) {
+        ++loads;
+        return ExpirableUserValue{id, "user@test.com", "Loaded " + std::to_string(loads)};
+    };
+
+    auto loaded = cache.get_or_load<IdTag>(1, load);
+    EXPECT_EQ(loaded.freshness, multi_index_lru::Freshness::fresh);
+    EXPECT_EQ(loaded.iterator->name, "Loaded 1");
+    EXPECT_EQ(cache.get_or_load<IdTag>(1, load).iterator->name, "Loaded 1");
+    EXPECT_EQ(loads, 1);
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_EQ(cache.get_or_load<IdTag>(1, load).iterator->name, "Loaded 2");
+    EXPECT_EQ(loads, 2);
+
+    // Loader failures fall back to the stale element
+    std::this_thread::sleep_for(60ms);
+    auto failed = cache.get_or_load<IdTag>(1, [](int) -> std::optional<ExpirableUserValue> {
+        return std::nullopt;
+    });
+    EXPECT_TRUE(failed.stale());
+    EXPECT_EQ(failed.iterator->name, "Loaded 2");
+
+    auto thrown = cache.get_or_load<IdTag>(1, [](int) -> ExpirableUserValue {
+        throw std::runtime_error("backend down");
+    });
+    EXPECT_TRUE(thrown.stale());
+    EXPECT_EQ(thrown.iterator->name, "Loaded 2");
+
+    // Without an element to fall back to, the failure surfaces
+    EXPECT_THROW(cache.get_or_load<IdTag>(2, [](int) -> ExpirableUserValue {
+        throw std::runtime_error("backend down");
+    }), std::runtime_error);
+    auto missing = cache.get_or_load<IdTag>(2, [](int) { return std::optional<ExpirableUserValue>{}; });
+    EXPECT_FALSE(missing.found());
+}
+
+using UniqueNameCache = multi_index_lru::ExpirableContainer<
+    ExpirableUserValue,
+    boost::multi_index::indexed_by<
+        boost::multi_index::ordered_unique<
+            boost::multi_index::tag<IdTag>,
+            IdExtractor<multi_index_lru::detail::TimestampedValue<ExpirableUserValue>>>,
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<NameTag>,
+            NameExtractor>>>;
+
+TEST(ExpirableStaleTest, GetOrLoadRejectsUnusableValues) {
+    UniqueNameCache cache(10, 40ms);
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    std::this_thread::sleep_for(60ms);
+    cache.insert(ExpirableUserValue{3, "carol@test.com", "Carol"});
+
+    // Loaded value has another key: dropped, not stored under its own key
+    auto wrong_key = cache.get_or_load<IdTag>(1, [](int) {
+        return ExpirableUserValue{4, "dave@test.com", "Dave"};
+    });
+    EXPECT_FALSE(wrong_key.found());
+    EXPECT_EQ(wrong_key.iterator, cache.end<IdTag>());
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(4));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(1));  // expired, no stale window
+
+    // Loaded value collides with another element on the name index
+    auto collided = cache.get_or_load<IdTag>(2, [](int id) {
+        return ExpirableUserValue{id, "bob@test.com", "Carol"};
+    });
+    EXPECT_FALSE(collided.found());
+    EXPECT_EQ(collided.iterator, cache.end<IdTag>());
+    EXPECT_EQ(cache.find<IdTag>(3)->name, "Carol");
+
+    // With a stale-if-error window, both fall back to the stale element
+    cache.set_stale_policy({.stale_if_error = 1h});
+    cache.insert(ExpirableUserValue{5, "eve@test.com", "Eve"});
+    std::this_thread::sleep_for(60ms);
+    auto stale = cache.get_or_load<IdTag>(5, [](int) {
+        return ExpirableUserValue{5, "eve@test.com", "Carol"};
+    });
+    EXPECT_TRUE(stale.stale());
+    EXPECT_EQ(stale.iterator->name, "Eve");
+    EXPECT_TRUE(cache.get_or_load<IdTag>(5, [](int) {
+        return ExpirableUserValue{6, "frank@test.com", "Frank"};
+    }).stale());
+}
+
+TEST(ExpirableStaleTest, InsertOrAssign) {
+    MultiNameCache cache(2, 1h);
+    EXPECT_TRUE(cache.insert_or_assign(ExpirableUserValue{1, "a@test.com", "John"}));
+    EXPECT_FALSE(cache.insert_or_assign(ExpirableUserValue{1, "a@test.com", "Jane"}));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.find<IdTag>(1)->name, "Jane");
+
+    EXPECT_TRUE(cache.insert_or_assign(ExpirableUserValue{2, "b@test.com", "Bob"}));
+    EXPECT_TRUE(cache.insert_or_assign(ExpirableUserValue{3, "c@test.com", "Carol"}));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.contains<IdTag>(1));  // evicted as least recently used
+}
+
+TEST(ExpirableStaleTest, ParameterValidation) {
+    EasierUserCache cache(10, 1h);
+    EXPECT_THROW(cache.set_stale_policy({.stale_while_revalidate = -1ms}), std::invalid_argument);
+    EXPECT_THROW(cache.set_stale_policy({.stale_if_error = -1ms}), std::invalid_argument);
+    cache.set_stale_policy({.stale_while_revalidate = 5s, .stale_if_error = 1min});
+    EXPECT_EQ(cache.stale_policy().stale_while_revalidate, 5s);
+    EXPECT_EQ(cache.stale_policy().stale_if_error, 1min);
+}
+
+// =============================================================================
+// Expire-after-write
+// =============================================================================
+
+TEST(ExpirableWriteTest, HitsDoNotRefreshTimestamp) {
+    EasierUserCache cache(10, 80ms, multi_index_lru::ExpirationPolicy::after_write);
+    EXPECT_EQ(cache.expiration_policy(), multi_index_lru::ExpirationPolicy::after_write);
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    const auto written = cache.find_no_update<IdTag>(1).base()->last_accessed;
+
+    // Read constantly: an after-access cache would never expire the element
+    for (int i = 0; i < 6; ++i) {
+        std::this_thread::sleep_for(10ms);
+        ASSERT_NE(cache.find<IdTag>(1), cache.end<IdTag>());
+        EXPECT_TRUE(cache.contains<IdTag>(1));
+        EXPECT_FALSE(cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"}));
+    }
+    EXPECT_EQ(cache.find_no_update<IdTag>(1).base()->last_accessed, written);
+
+    std::this_thread::sleep_for(40ms);
+    EXPECT_EQ(cache.find<IdTag>(1), cache.end<IdTag>());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ExpirableWriteTest, WritesRestartTTL) {
+    EasierUserCache cache(10, 80ms, multi_index_lru::ExpirationPolicy::after_write);
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_FALSE(cache.insert_or_assign(ExpirableUserValue{1, "alice@test.com", "Alice v2"}));
+    EXPECT_TRUE(cache.modify<IdTag>(2, [](ExpirableUserValue& user) { user.name = "Bob v2"; }));
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(cache.find<IdTag>(1)->name, "Alice v2");
+    EXPECT_EQ(cache.find<IdTag>(2)->name, "Bob v2");
+}
+
+TEST(ExpirableWriteTest, HitsStillUpdateLRUOrder) {
+    EasierUserCache cache(2, 1h, multi_index_lru::ExpirationPolicy::after_write);
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    ASSERT_NE(cache.find<IdTag>(1), cache.end<IdTag>());
+    cache.insert(ExpirableUserValue{3, "carol@test.com", "Carol"});
+    EXPECT_TRUE(cache.contains<IdTag>(1));
+    EXPECT_FALSE(cache.contains<IdTag>(2));
+}
+
+// =============================================================================
+// TTL jitter
+// =============================================================================
+
+TEST(ExpirableJitterTest, RandomJitterSpreadsTimestamps) {
+    EasierUserCache cache(1000, 1h);
+    cache.set_ttl_jitter(10min);
+    EXPECT_EQ(cache.ttl_jitter(), 10min);
+    EXPECT_EQ(cache.jitter_mode(), multi_index_lru::JitterMode::random);
+
+    const auto before = std::chrono::steady_clock::now();
+    for (int i = 0; i < 200; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    const auto after = std::chrono::steady_clock::now();
+
+    auto earliest = after;
+    auto latest = before - 1h;
+    for (int i = 0; i < 200; ++i) {
+        const auto stamped = cache.find_no_update<IdTag>(i).base()->last_accessed;
+        EXPECT_GE(stamped, before - 10min);
+        EXPECT_LE(stamped, after);
+        earliest = std::min(earliest, stamped);
+        latest = std::max(latest, stamped);
+    }
+    // 200 uniform offsets within 10 minutes leave no 5-minute gap at either end
+    EXPECT_LT(earliest, before - 8min);
+    EXPECT_GT(latest, after - 2min);
+
+    // Hits draw a new offset but stay within the jitter
+    const auto hit_time = std::chrono::steady_clock::now();
+    ASSERT_NE(cache.find<IdTag>(0), cache.end<IdTag>());
+    EXPECT_GE(cache.find_no_update<IdTag>(0).base()->last_accessed, hit_time - 10min);
+}
+
+TEST(ExpirableJitterTest, PerKeyJitterIsDeterministic) {
+    EasierUserCache first(100, 1h);
+    EasierUserCache second(100, 1h);
+    first.set_ttl_jitter(10min, multi_index_lru::JitterMode::per_key);
+    second.set_ttl_jitter(10min, multi_index_lru::JitterMode::per_key);
+
+    // offset = insertion time - stored timestamp, known up to the insertion's duration
+    auto insert = [](EasierUserCache& cache, int id) {
+        const auto before = std::chrono::steady_clock::now();
+        cache.insert(ExpirableUserValue{id, "user@test.com", "User"});
+        const auto after = std::chrono::steady_clock::now();
+        const auto stamped = cache.find_no_update<IdTag>(id).base()->last_accessed;
+        return std::pair{before - stamped, after - stamped};
+    };
+    bool offsets_differ = false;
+    for (int id = 0; id < 50; ++id) {
+        const auto [first_low, first_high] = insert(first, id);
+        const auto [second_low, second_high] = insert(second, id);
+        EXPECT_LE(first_low, second_high);
+        EXPECT_LE(second_low, first_high);
+        offsets_differ = offsets_differ || first_high < insert(first, id + 1000).first;
+    }
+    EXPECT_TRUE(offsets_differ);
+}
+
+TEST(ExpirableJitterTest, JitteredElementsExpireEarlier) {
+    EasierUserCache cache(100, 200ms);
+    cache.set_ttl_jitter(150ms);
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    std::this_thread::sleep_for(125ms);
+    // Roughly half have an effective TTL under 125ms; without jitter none would
+    int live = 0;
+    for (int i = 0; i < 100; ++i) {
+        live += cache.contains<IdTag>(i) ? 1 : 0;
+    }
+    EXPECT_LT(live, 100);
+    EXPECT_GT(live, 0);
+}
+
+TEST(ExpirableJitterTest, ParameterValidation) {
+    EasierUserCache cache(10, 1min);
+    EXPECT_THROW(cache.set_ttl_jitter(-1ms), std::invalid_argument);
+    EXPECT_THROW(cache.set_ttl_jitter(1min), std::invalid_argument);
+    cache.set_ttl_jitter(30s);
+    EXPECT_THROW(cache.set_ttl(30s), std::invalid_argument);
+    cache.set_ttl(31s);
+
+    // std::pair has no std::hash
+    struct PairKey {
+        using result_type = std::pair<int, int>;
+        result_type operator()(const multi_index_lru::detail::TimestampedValue<ExpirableUserValue>& wrapped) const {
+            return {wrapped.value.id, 0};
+        }
+    };
+    multi_index_lru::ExpirableContainer<
+        ExpirableUserValue,
+        boost::multi_index::indexed_by<
+            boost::multi_index::ordered_unique<boost::multi_index::tag<IdTag>, PairKey>>>
+        pair_cache(10, 1min);
+    EXPECT_THROW(pair_cache.set_ttl_jitter(1s, multi_index_lru::JitterMode::per_key),
+                 std::invalid_argument);
+    pair_cache.set_ttl_jitter(1s);
+    EXPECT_TRUE(pair_cache.insert(ExpirableUserValue{1, "user@test.com", "User"}));
+}
+
+// =============================================================================
+// Slot timestamps
+// =============================================================================
+
+using SlotUserCache = multi_index_lru::ExpirableContainer<
+    ExpirableUserValue,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            IdExtractor<multi_index_lru::detail::SlottedValue<ExpirableUserValue>>>>,
+    std::allocator<ExpirableUserValue>,
+    multi_index_lru::slot_timestamps>;
+
+TEST(ExpirableSlotTest, ExpiresAndRefreshesLikeInline) {
+    SlotUserCache cache(10, 60ms);
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+
+    std::this_thread::sleep_for(40ms);
+    EXPECT_NE(cache.find<IdTag>(1), cache.end<IdTag>());  // refreshed
+    std::this_thread::sleep_for(40ms);
+    EXPECT_TRUE(cache.contains<IdTag>(1));
+    EXPECT_FALSE(cache.contains<IdTag>(2));
+
+    std::this_thread::sleep_for(80ms);
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ExpirableSlotTest, HitsWithinAnEighthOfTheTtlKeepTheLruPosition) {
+    SlotUserCache cache(10, 4s);  // elements move to the front at most every 500 ms
+    for (int i = 1; i <= 3; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+
+    // Recently inserted: the hit restamps the array but leaves 1 at the LRU tail
+    const auto stamped = cache.lru_last_accessed();
+    ASSERT_NE(cache.find<IdTag>(1), cache.end<IdTag>());
+    EXPECT_GE(cache.lru_last_accessed(), stamped);
+    EXPECT_TRUE(cache.evict_lru());
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(1));
+
+    // Past TTL/8 since the last access, a hit moves the element to the front
+    std::this_thread::sleep_for(600ms);
+    ASSERT_NE(cache.find<IdTag>(2), cache.end<IdTag>());
+    EXPECT_TRUE(cache.evict_lru());
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(3));
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(2));
+
+    // Expiring after write, every hit moves the element
+    SlotUserCache after_write(10, 4s, multi_index_lru::ExpirationPolicy::after_write);
+    for (int i = 1; i <= 3; ++i) {
+        after_write.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    ASSERT_NE(after_write.find<IdTag>(1), after_write.end<IdTag>());
+    EXPECT_TRUE(after_write.evict_lru());
+    EXPECT_TRUE(after_write.contains_no_update<IdTag>(1));
+    EXPECT_FALSE(after_write.contains_no_update<IdTag>(2));
+}
+
+TEST(ExpirableSlotTest, SlotsAreReused) {
+    SlotUserCache cache(3, 1h);
+    for (int i = 0; i < 3; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    const auto usage = cache.memory_usage();
+
+    // Every removal path releases its slot for the next insert
+    cache.insert(ExpirableUserValue{3, "user@test.com", "User"});  // evicts 0
+    EXPECT_TRUE(cache.erase<IdTag>(1));
+    cache.insert(ExpirableUserValue{4, "user@test.com", "User"});
+    EXPECT_TRUE(cache.modify<IdTag>(2, [](ExpirableUserValue& user) { user.name = "Carol"; }));
+    EXPECT_FALSE(cache.modify<IdTag>(3, [](ExpirableUserValue& user) { user.id = 4; }));  // collides
+    EXPECT_FALSE(cache.insert_or_assign(ExpirableUserValue{2, "carol@test.com", "Carol v2"}));
+    EXPECT_TRUE(cache.insert(ExpirableUserValue{5, "user@test.com", "User"}));
+    EXPECT_TRUE(cache.evict_lru());
+    cache.insert(ExpirableUserValue{6, "user@test.com", "User"});
+    cache.set_capacity(1);
+    cache.set_capacity(3);
+    cache.insert(ExpirableUserValue{7, "user@test.com", "User"});
+    cache.insert(ExpirableUserValue{8, "user@test.com", "User"});
+
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_EQ(cache.memory_usage().index_links, usage.index_links);
+    for (int id : {6, 7, 8}) {
+        EXPECT_TRUE(cache.contains<IdTag>(id));
+    }
+
+    cache.clear();
+    EXPECT_LT(cache.memory_usage().index_links, usage.index_links);
+    EXPECT_TRUE(cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"}));
+}
+
+TEST(ExpirableSlotTest, ExtractInsertRestartsTimestamp) {
+    SlotUserCache source(10, 60ms);
+    SlotUserCache target(10, 60ms);
+    source.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    source.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+
+    std::this_thread::sleep_for(40ms);
+    EXPECT_TRUE(target.insert(source.extract<IdTag>(1)));
+    EXPECT_FALSE(source.contains<IdTag>(1));
+
+    std::this_thread::sleep_for(40ms);
+    EXPECT_TRUE(target.contains<IdTag>(1));
+    EXPECT_FALSE(source.contains<IdTag>(2));
+
+    auto node = target.extract<IdTag>(1);
+    target.insert(ExpirableUserValue{1, "alice@test.com", "Alice v2"});
+    EXPECT_FALSE(target.insert(std::move(node)));
+    EXPECT_FALSE(node.empty());
+    EXPECT_EQ(target.find<IdTag>(1)->name, "Alice v2");
+}
+
+TEST(ExpirableSlotTest, MemoryUsageCountsTheArray) {
+    SlotUserCache cache(100, 1h);
+    for (int i = 0; i < 50; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    const auto usage = cache.memory_usage();
+    EXPECT_EQ(usage.node_values,
+              50 * sizeof(multi_index_lru::detail::SlottedValue<ExpirableUserValue>));
+    EXPECT_GE(usage.index_links, 50 * (sizeof(std::chrono::steady_clock::time_point) + 3 * sizeof(void*)));
+    EXPECT_LE(sizeof(multi_index_lru::detail::SlottedValue<ExpirableUserValue>),
+              sizeof(multi_index_lru::detail::TimestampedValue<ExpirableUserValue>));
+    EXPECT_TRUE(cache.lru_last_accessed().has_value());
+}
+
+// =============================================================================
+// Generation timestamps
+// =============================================================================
+
+using GenerationUserCache = multi_index_lru::ExpirableContainer<
+    ExpirableUserValue,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            IdExtractor<multi_index_lru::detail::GenerationValue<ExpirableUserValue>>>>,
+    std::allocator<ExpirableUserValue>,
+    multi_index_lru::generation_timestamps>;
+
+TEST(ExpirableGenerationTest, ExpiresWithinOneGeneration) {
+    GenerationUserCache cache(10, 1s);  // 125 ms generations
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+
+    // Checks land at least 200 ms away from every expiry, so oversleeping is harmless
+    std::this_thread::sleep_for(500ms);
+    EXPECT_TRUE(cache.contains<IdTag>(1));  // refreshed, expires 875-1000 ms from now
+    std::this_thread::sleep_for(650ms);
+    EXPECT_TRUE(cache.contains<IdTag>(1));
+    EXPECT_FALSE(cache.contains<IdTag>(2));
+
+    // Never served past the TTL: expired at most one generation early
+    std::this_thread::sleep_for(1050ms);
+    EXPECT_FALSE(cache.contains<IdTag>(1));
+}
+
+TEST(ExpirableGenerationTest, CleanupDropsExpiredGenerations) {
+    GenerationUserCache cache(100, 1s);  // 125 ms generations
+    for (int i = 0; i < 20; ++i) {
+        cache.insert(ExpirableUserValue{i, "old@test.com", "Old"});
+    }
+    // Removals outside cleanup keep the per-generation counts exact
+    EXPECT_TRUE(cache.erase<IdTag>(0));
+    EXPECT_FALSE(cache.extract<IdTag>(1).empty());
+    EXPECT_TRUE(cache.evict_lru());  // 2
+
+    std::this_thread::sleep_for(500ms);
+    for (int i = 100; i < 110; ++i) {
+        cache.insert(ExpirableUserValue{i, "new@test.com", "New"});
+    }
+    EXPECT_TRUE(cache.modify<IdTag>(3, [](ExpirableUserValue& user) { user.name = "Moved"; }));
+    EXPECT_FALSE(cache.insert_or_assign(ExpirableUserValue{4, "new@test.com", "Moved"}));
+
+    std::this_thread::sleep_for(650ms);
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.size(), 12);
+    for (int id : {3, 4, 100, 109}) {
+        EXPECT_TRUE(cache.contains_no_update<IdTag>(id));
+    }
+
+    std::this_thread::sleep_for(1050ms);
+    cache.cleanup_expired();
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(ExpirableGenerationTest, HitsWithinAGenerationLeaveTheNode) {
+    GenerationUserCache cache(10, 8h);  // 1 h generations
+    for (int i = 1; i <= 3; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+    const auto generation = cache.find_no_update<IdTag>(1).base()->generation;
+    const auto stamped = cache.lru_last_accessed();
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NE(cache.find<IdTag>(1), cache.end<IdTag>());
+    }
+    EXPECT_EQ(cache.find_no_update<IdTag>(1).base()->generation, generation);
+    EXPECT_EQ(cache.lru_last_accessed(), stamped);
+    EXPECT_LE(*stamped, std::chrono::steady_clock::now());
+
+    // 1 was not relocated: it is still the LRU tail
+    EXPECT_TRUE(cache.evict_lru());
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(1));
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(2));
+
+    const auto usage = cache.memory_usage();
+    EXPECT_EQ(usage.node_values, 2 * sizeof(multi_index_lru::detail::GenerationValue<ExpirableUserValue>));
+    EXPECT_GE(usage.index_links, 10 * sizeof(std::size_t));  // the ring of counts
+}
+
+TEST(ExpirableGenerationTest, HitsFromAnOlderGenerationMoveTheNode) {
+    GenerationUserCache cache(10, 8s);  // 1 s generations
+    for (int i = 1; i <= 3; ++i) {
+        cache.insert(ExpirableUserValue{i, "user@test.com", "User"});
+    }
+
+    // Longer than a generation, far shorter than the TTL
+    std::this_thread::sleep_for(1100ms);
+    ASSERT_NE(cache.find<IdTag>(1), cache.end<IdTag>());
+    EXPECT_TRUE(cache.evict_lru());
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(1));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(2));
+}
+
+TEST(ExpirableGenerationTest, StaleWindowsGrowTheRing) {
+    GenerationUserCache cache(10, 40ms);
+    cache.set_stale_policy({.stale_while_revalidate = 2s, .stale_if_error = 0ms});
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+
+    // Past the TTL, well within the stale window
+    std::this_thread::sleep_for(100ms);
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_TRUE(cache.find_allow_stale<IdTag>(1).stale());
+
+    cache.set_stale_policy({});
+    cache.cleanup_expired();
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(ExpirableGenerationTest, SetTtlRebucketsTheGenerations) {
+    GenerationUserCache cache(10, 8s);  // 1 s generations
+    cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"});
+    cache.set_ttl(400ms);  // 50 ms generations
+    cache.insert(ExpirableUserValue{2, "bob@test.com", "Bob"});
+    EXPECT_TRUE(cache.contains<IdTag>(2));
+
+    // Accesses after the change expire at most one new generation early
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(cache.contains<IdTag>(2));
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(cache.contains<IdTag>(2));
+
+    // The per-generation counts still cover both elements
+    std::this_thread::sleep_for(500ms);
+    cache.cleanup_expired();
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(ExpirableGenerationTest, ParameterValidation) {
+    EXPECT_THROW(GenerationUserCache(10, 1min, multi_index_lru::ExpirationPolicy::after_write),
+                 std::invalid_argument);
+    GenerationUserCache cache(10, 1min, multi_index_lru::ExpirationPolicy::after_access);
+    EXPECT_THROW(cache.set_ttl_jitter(1s), std::invalid_argument);
+    cache.set_ttl_jitter(0s);
+    cache.set_ttl(2min);
+    EXPECT_TRUE(cache.insert(ExpirableUserValue{1, "alice@test.com", "Alice"}));
+}
+
 // =============================================================================
 // ExpirableContainer with Zerialize Integration
 // =============================================================================
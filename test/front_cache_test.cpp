@@ -0,0 +1,152 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/front_cache.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct IdTag {};
+
+struct Quote {
+    int id;
+    long price;
+};
+
+using QuoteCache = multi_index_lru::ShardedContainer<
+    Quote,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<Quote, int, &Quote::id>>>>;
+
+using QuoteFront = multi_index_lru::FrontCache<QuoteCache, IdTag>;
+
+TEST(FrontCacheTest, RepeatedLookupsHit) {
+    QuoteCache cache(100, 4);
+    cache.insert(Quote{1, 100});
+
+    QuoteFront front(cache, 16, 1h);
+    EXPECT_EQ(front.capacity(), 16U);
+
+    const Quote* hit = front.find(1);
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(hit->price, 100);
+    EXPECT_EQ(front.misses(), 1U);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_NE(front.find(1), nullptr);
+    }
+    EXPECT_EQ(front.hits(), 10U);
+
+    // Misses are not cached
+    EXPECT_EQ(front.find(2), nullptr);
+    EXPECT_EQ(front.find(2), nullptr);
+    EXPECT_EQ(front.misses(), 3U);
+}
+
+TEST(FrontCacheTest, WritesInvalidateEntries) {
+    QuoteCache cache(100, 4);
+    cache.insert(Quote{1, 100});
+    QuoteFront front(cache, 16, 1h);
+    ASSERT_NE(front.find(1), nullptr);
+
+    cache.insert_or_assign(Quote{1, 101});
+    const Quote* hit = front.find(1);
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(hit->price, 101);
+
+    cache.erase<IdTag>(1);
+    EXPECT_EQ(front.find(1), nullptr);
+
+    cache.insert(Quote{1, 102});
+    ASSERT_NE(front.find(1), nullptr);
+    cache.clear();
+    EXPECT_FALSE(front.contains(1));
+}
+
+TEST(FrontCacheTest, MaxAgeForcesRefill) {
+    QuoteCache cache(100, 1);
+    cache.insert(Quote{1, 100});
+    QuoteFront front(cache, 4, 20ms);
+
+    ASSERT_NE(front.find(1), nullptr);
+    ASSERT_NE(front.find(1), nullptr);
+    EXPECT_EQ(front.hits(), 1U);
+
+    std::this_thread::sleep_for(30ms);
+    ASSERT_NE(front.find(1), nullptr);
+    EXPECT_EQ(front.misses(), 2U);
+
+    front.invalidate(1);
+    ASSERT_NE(front.find(1), nullptr);
+    EXPECT_EQ(front.misses(), 3U);
+}
+
+TEST(FrontCacheTest, ParameterValidation) {
+    QuoteCache cache(10, 1);
+    EXPECT_THROW((QuoteFront{cache, 0}), std::invalid_argument);
+    EXPECT_THROW((QuoteFront{cache, 4, 0ms}), std::invalid_argument);
+}
+
+TEST(FrontCacheTest, ConcurrentReadersNeverSeeOldValues) {
+    QuoteCache cache(100, 4);
+    for (int i = 0; i < 8; ++i) {
+        cache.insert(Quote{i, 0});
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> regressions{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            QuoteFront front(cache, 16, 1h);
+            std::vector<long> last(8, 0);
+            while (!done.load(std::memory_order_acquire)) {
+                for (int i = 0; i < 8; ++i) {
+                    const Quote* hit = front.find(i);
+                    if (hit == nullptr || hit->price < last[i]) {
+                        regressions.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        last[i] = hit->price;
+                    }
+                }
+            }
+        });
+    }
+
+    for (long price = 1; price <= 500; ++price) {
+        cache.insert_or_assign(Quote{static_cast<int>(price % 8), price});
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(regressions.load(), 0);
+}
+
+}  // namespace
@@ -0,0 +1,149 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/ingest_pipeline.hpp>
+#include <multi_index_lru/sbe_cache.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct MockSbeView {
+    std::span<const uint8_t> bytes;
+
+    std::uint32_t security_id() const {
+        return static_cast<std::uint32_t>(bytes[0]) |
+               (static_cast<std::uint32_t>(bytes[1]) << 8U) |
+               (static_cast<std::uint32_t>(bytes[2]) << 16U) |
+               (static_cast<std::uint32_t>(bytes[3]) << 24U);
+    }
+};
+
+std::vector<uint8_t> MakePayload(std::uint32_t security_id) {
+    return {
+        static_cast<uint8_t>(security_id & 0xFFU),
+        static_cast<uint8_t>((security_id >> 8U) & 0xFFU),
+        static_cast<uint8_t>((security_id >> 16U) & 0xFFU),
+        static_cast<uint8_t>((security_id >> 24U) & 0xFFU),
+    };
+}
+
+struct SecurityTag {};
+
+using Entry = multi_index_lru::SbeEntryWithKeys_t<std::uint32_t>;
+
+using QuoteCache = multi_index_lru::Container<
+    Entry,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<SecurityTag>,
+            multi_index_lru::sbe_key<0, Entry>>>>;
+
+using Pipeline = multi_index_lru::IngestPipeline<std::vector<uint8_t>, Entry>;
+
+TEST(IngestPipelineTest, DeliversInSubmissionOrder) {
+    auto builder = multi_index_lru::make_sbe_entry_builder<Entry>(
+        [](std::span<const uint8_t> bytes) { return MockSbeView{bytes}; },
+        multi_index_lru::make_sbe_field<std::uint32_t>(&MockSbeView::security_id));
+
+    // Earlier batches take longer, so workers finish out of order
+    Pipeline pipeline([&builder](const std::vector<uint8_t>& bytes) {
+        if (bytes[0] % 10 == 0) {
+            std::this_thread::sleep_for(1ms);
+        }
+        return builder.build(bytes);
+    }, 3, 4);
+
+    QuoteCache cache(1000);
+    std::vector<std::uint32_t> order;
+    auto insert = [&](Entry&& entry) {
+        order.push_back(std::get<0>(entry.keys));
+        cache.insert(std::move(entry));
+    };
+
+    std::uint32_t next = 0;
+    for (int b = 0; b < 20; ++b) {
+        Pipeline::batch_type batch;
+        for (int i = 0; i < 10; ++i) {
+            batch.push_back(MakePayload(next++));
+        }
+        pipeline.submit(std::move(batch), insert);
+        EXPECT_LE(pipeline.in_flight(), pipeline.capacity());
+        pipeline.poll(insert);
+    }
+    pipeline.drain(insert);
+
+    ASSERT_EQ(order.size(), 200U);
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_EQ(cache.size(), 200U);
+    EXPECT_EQ(pipeline.in_flight(), 0U);
+}
+
+TEST(IngestPipelineTest, TrySubmitAppliesBackpressure) {
+    Pipeline pipeline([](const std::vector<uint8_t>& bytes) {
+        return Entry({bytes[0]}, bytes);
+    }, 1, 2);
+
+    EXPECT_TRUE(pipeline.try_submit({{1}}));
+    EXPECT_TRUE(pipeline.try_submit({{2}}));
+    EXPECT_FALSE(pipeline.try_submit({{3}}));
+
+    std::size_t delivered = pipeline.drain([](Entry&&) {});
+    EXPECT_EQ(delivered, 2U);
+    EXPECT_TRUE(pipeline.try_submit({{3}}));
+    EXPECT_EQ(pipeline.drain([](Entry&&) {}), 1U);
+}
+
+TEST(IngestPipelineTest, BuildErrorsSurfaceInOrder) {
+    Pipeline pipeline([](const std::vector<uint8_t>& bytes) {
+        if (bytes.empty()) {
+            throw std::runtime_error("truncated message");
+        }
+        return Entry({bytes[0]}, bytes);
+    }, 2, 8);
+
+    pipeline.submit({{1}, {2}});
+    pipeline.submit({{3}, {}});
+    pipeline.submit({{4}});
+
+    std::vector<std::uint32_t> seen;
+    auto sink = [&seen](Entry&& entry) { seen.push_back(std::get<0>(entry.keys)); };
+    EXPECT_THROW(pipeline.drain(sink), std::runtime_error);
+    EXPECT_EQ(seen, (std::vector<std::uint32_t>{1, 2}));
+
+    // The failed batch is dropped; later batches are still delivered
+    EXPECT_EQ(pipeline.drain(sink), 1U);
+    EXPECT_EQ(seen.back(), 4U);
+}
+
+TEST(IngestPipelineTest, ParameterValidation) {
+    auto build = [](const std::vector<uint8_t>& bytes) { return Entry({0U}, bytes); };
+    EXPECT_THROW((Pipeline{build, 0, 1}), std::invalid_argument);
+    EXPECT_THROW((Pipeline{build, 1, 0}), std::invalid_argument);
+}
+
+}  // namespace
@@ -0,0 +1,118 @@
+#include <multi_index_lru/lazy_index.hpp>
+
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+namespace {
+
+struct IdTag {};
+struct EmailTag {};
+struct AgeTag {};
+
+struct User {
+    int id;
+    std::string email;
+    int age;
+};
+
+using Users = multi_index_lru::LazyIndexedContainer<
+    User,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<User, int, &User::id>>>,
+    multi_index_lru::lazy_indexed_by<
+        multi_index_lru::lazy_hashed_non_unique<
+            EmailTag, boost::multi_index::member<User, std::string, &User::email>>,
+        multi_index_lru::lazy_ordered_non_unique<
+            AgeTag, boost::multi_index::member<User, int, &User::age>>>>;
+
+TEST(LazyIndexTest, BuiltOnFirstQuery) {
+    Users users(10);
+    users.emplace(User{1, "a@test.com", 30});
+    users.emplace(User{2, "b@test.com", 40});
+    EXPECT_FALSE(users.index_built<EmailTag>());
+
+    EXPECT_TRUE(users.contains<IdTag>(1));
+    EXPECT_FALSE(users.index_built<EmailTag>());
+
+    auto it = users.find<EmailTag>(std::string("b@test.com"));
+    ASSERT_NE(it, users.end<EmailTag>());
+    EXPECT_EQ(it->id, 2);
+    EXPECT_TRUE(users.index_built<EmailTag>());
+    EXPECT_FALSE(users.index_built<AgeTag>());
+
+    // Maintained incrementally after the build
+    users.emplace(User{3, "c@test.com", 40});
+    EXPECT_TRUE(users.contains_no_update<EmailTag>(std::string("c@test.com")));
+
+    users.build_indices();
+    EXPECT_TRUE(users.index_built<AgeTag>());
+    auto [first, last] = users.equal_range_no_update<AgeTag>(40);
+    EXPECT_EQ(std::distance(first, last), 2);
+    EXPECT_EQ(users.count<AgeTag>(30), 1U);
+}
+
+TEST(LazyIndexTest, EvictionAndEraseKeepIndicesConsistent) {
+    Users users(2);
+    users.emplace(User{1, "a@test.com", 30});
+    users.build_index<EmailTag>();
+    users.emplace(User{2, "b@test.com", 30});
+
+    // Duplicate id refreshes without evicting
+    EXPECT_FALSE(users.emplace(User{1, "other@test.com", 30}));
+    EXPECT_TRUE(users.contains_no_update<EmailTag>(std::string("b@test.com")));
+
+    // id=2 is LRU and gets evicted
+    users.emplace(User{3, "c@test.com", 30});
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("b@test.com")));
+    EXPECT_TRUE(users.contains_no_update<EmailTag>(std::string("a@test.com")));
+    EXPECT_EQ(users.count<EmailTag>(std::string("c@test.com")), 1U);
+
+    EXPECT_TRUE(users.erase<EmailTag>(std::string("a@test.com")));
+    EXPECT_FALSE(users.contains_no_update<IdTag>(1));
+    EXPECT_TRUE(users.erase<IdTag>(3));
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("c@test.com")));
+    EXPECT_TRUE(users.empty());
+
+    users.emplace(User{4, "d@test.com", 30});
+    users.set_capacity(1);
+    users.emplace(User{5, "e@test.com", 30});
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("d@test.com")));
+    users.clear();
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("e@test.com")));
+}
+
+TEST(LazyIndexTest, ModifyReindexesLazyKeys) {
+    Users users(10);
+    users.emplace(User{1, "a@test.com", 30});
+    users.emplace(User{2, "b@test.com", 30});
+    users.build_indices();
+
+    EXPECT_TRUE(users.modify<EmailTag>(std::string("a@test.com"), [](User& user) { user.email = "z@test.com"; }));
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("a@test.com")));
+    EXPECT_EQ(users.find_no_update<EmailTag>(std::string("z@test.com"))->id, 1);
+    EXPECT_EQ(users.begin()->id, 1);  // moved to front
+
+    // Collision on the eager unique index erases the element everywhere
+    EXPECT_FALSE(users.modify<IdTag>(1, [](User& user) { user.id = 2; }));
+    EXPECT_FALSE(users.contains_no_update<EmailTag>(std::string("z@test.com")));
+    EXPECT_EQ(users.size(), 1U);
+}
+
+TEST(LazyIndexTest, FindThroughLazyIndexRefreshesLru) {
+    Users users(2);
+    users.emplace(User{1, "a@test.com", 30});
+    users.emplace(User{2, "b@test.com", 30});
+
+    EXPECT_TRUE(users.contains<EmailTag>(std::string("a@test.com")));
+    users.emplace(User{3, "c@test.com", 30});
+    EXPECT_TRUE(users.contains_no_update<IdTag>(1));
+    EXPECT_FALSE(users.contains_no_update<IdTag>(2));
+}
+
+}  // namespace
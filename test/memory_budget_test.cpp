@@ -0,0 +1,138 @@
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/expirable_container.hpp>
+#include <multi_index_lru/memory_budget.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+namespace {
+
+struct IdTag {};
+
+struct Entry {
+    int id;
+    std::chrono::steady_clock::time_point received_at;
+};
+
+using Indices = boost::multi_index::indexed_by<
+    boost::multi_index::hashed_unique<
+        boost::multi_index::tag<IdTag>,
+        boost::multi_index::member<Entry, int, &Entry::id>>>;
+
+using ExpirableCache = multi_index_lru::ExpirableContainer<Entry, Indices>;
+using PlainCache = multi_index_lru::Container<Entry, Indices>;
+
+Entry make_entry(int id) { return Entry{id, std::chrono::steady_clock::now()}; }
+
+TEST(MemoryBudgetTest, EvictsFromCacheWithColdestTail) {
+    ExpirableCache cold(100, std::chrono::minutes(1));
+    ExpirableCache hot(100, std::chrono::minutes(1));
+    for (int i = 0; i < 20; ++i) {
+        cold.insert(make_entry(i));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (int i = 0; i < 20; ++i) {
+        hot.insert(make_entry(i));
+    }
+
+    const auto full = cold.memory_usage().total() + hot.memory_usage().total();
+    const auto per_element = (full - ExpirableCache(100, std::chrono::minutes(1)).memory_usage().total() * 2) / 40;
+
+    multi_index_lru::MemoryBudget budget(full - 5 * per_element);
+    auto cold_reg = budget.add(cold);
+    auto hot_reg = budget.add(hot);
+    EXPECT_EQ(budget.cache_count(), 2U);
+    EXPECT_EQ(budget.usage(), full);
+
+    EXPECT_EQ(budget.enforce(), 5U);
+    EXPECT_EQ(cold.size(), 15U);
+    EXPECT_EQ(hot.size(), 20U);
+    EXPECT_LE(budget.usage(), budget.budget());
+
+    // Touching the cold cache's elements makes the other cache the colder one
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (int i = 5; i < 20; ++i) {
+        EXPECT_NE(cold.find<IdTag>(i), cold.end<IdTag>());
+    }
+    budget.set_budget(budget.usage() - 3 * per_element);
+    EXPECT_EQ(budget.enforce(), 3U);
+    EXPECT_EQ(cold.size(), 15U);
+    EXPECT_EQ(hot.size(), 17U);
+}
+
+TEST(MemoryBudgetTest, ContainerRankedByProjectedTime) {
+    PlainCache plain(100);
+    ExpirableCache expirable(100, std::chrono::minutes(1));
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        expirable.insert(make_entry(i));
+        plain.insert(Entry{i, now - std::chrono::hours(1)});
+    }
+
+    multi_index_lru::MemoryBudget budget(1);
+    auto plain_reg = budget.add(plain, [](const Entry& entry) { return entry.received_at; });
+    auto expirable_reg = budget.add(expirable);
+
+    budget.set_budget(budget.usage() - 1);
+    EXPECT_EQ(budget.enforce(), 1U);
+    EXPECT_EQ(plain.size(), 9U);
+    EXPECT_EQ(plain.find<IdTag>(0), plain.end<IdTag>());
+    EXPECT_EQ(expirable.size(), 10U);
+
+    // A budget below the empty caches' overhead stops once nothing is left
+    budget.set_budget(1);
+    EXPECT_EQ(budget.enforce(), 19U);
+    EXPECT_TRUE(plain.empty());
+    EXPECT_TRUE(expirable.empty());
+    EXPECT_EQ(budget.enforce(), 0U);
+}
+
+TEST(MemoryBudgetTest, RegistrationLifetime) {
+    multi_index_lru::MemoryBudget budget(1024);
+    ExpirableCache cache(10, std::chrono::minutes(1));
+    {
+        auto reg = budget.add(cache);
+        EXPECT_TRUE(reg);
+        EXPECT_EQ(budget.cache_count(), 1U);
+
+        auto moved = std::move(reg);
+        EXPECT_FALSE(reg);
+        EXPECT_TRUE(moved);
+        EXPECT_EQ(budget.cache_count(), 1U);
+    }
+    EXPECT_EQ(budget.cache_count(), 0U);
+
+    std::size_t calls = 0;
+    auto custom = budget.add([&calls] { ++calls; return std::size_t{4096}; },
+                             [] { return std::optional<std::chrono::steady_clock::time_point>{}; },
+                             [] { return false; });
+    EXPECT_EQ(budget.usage(), 4096U);
+    EXPECT_EQ(budget.enforce(), 0U);  // over budget, but nothing to evict
+    EXPECT_GT(calls, 0U);
+    custom.reset();
+    EXPECT_FALSE(custom);
+    EXPECT_EQ(budget.usage(), 0U);
+}
+
+TEST(MemoryBudgetTest, ParameterValidation) {
+    EXPECT_THROW(multi_index_lru::MemoryBudget(0), std::invalid_argument);
+    multi_index_lru::MemoryBudget budget(1);
+    EXPECT_THROW(budget.set_budget(0), std::invalid_argument);
+    EXPECT_EQ(budget.budget(), 1U);
+
+    ExpirableCache cache(10, std::chrono::minutes(1));
+    EXPECT_EQ(cache.lru_last_accessed(), std::nullopt);
+    cache.insert(make_entry(1));
+    cache.insert(make_entry(2));
+    ASSERT_TRUE(cache.lru_last_accessed().has_value());
+    EXPECT_EQ(*cache.lru_last_accessed(), cache.find_no_update<IdTag>(1).base()->last_accessed);
+}
+
+}  // namespace
@@ -0,0 +1,208 @@
+#include <multi_index_lru/cold.hpp>
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/expirable_container.hpp>
+#include <multi_index_lru/lazy_index.hpp>
+#include <multi_index_lru/memory_usage.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+namespace {
+
+struct IdTag {};
+struct NameTag {};
+
+struct Point {
+    int id;
+    double x;
+};
+
+struct Document {
+    int id;
+    std::string name;
+    std::vector<std::string> tags;
+};
+
+std::size_t heap_bytes(const Document& doc) {
+    return multi_index_lru::heap_bytes(doc.name) + multi_index_lru::heap_bytes(doc.tags);
+}
+
+using PointCache = multi_index_lru::Container<
+    Point,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<Point, int, &Point::id>>>>;
+
+using DocumentIndices = boost::multi_index::indexed_by<
+    boost::multi_index::hashed_unique<
+        boost::multi_index::tag<IdTag>,
+        boost::multi_index::member<Document, int, &Document::id>>,
+    boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<NameTag>,
+        boost::multi_index::member<Document, std::string, &Document::name>>>;
+
+using DocumentCache = multi_index_lru::Container<Document, DocumentIndices>;
+
+Document make_document(int id, std::size_t name_length = 40) {
+    return Document{id, std::string(name_length, static_cast<char>('a' + id % 26)),
+                    {std::string(30, 't'), "short"}};
+}
+
+template <typename Cache>
+std::size_t recount_payload(const Cache& cache) {
+    std::size_t bytes = 0;
+    for (const auto& element : cache.get_sequenced()) {
+        bytes += multi_index_lru::detail::payload_bytes(element);
+    }
+    return bytes;
+}
+
+TEST(MemoryUsageTest, HeapBytesOfStandardTypes) {
+    EXPECT_EQ(multi_index_lru::heap_bytes(std::string("sso")), 0U);
+    const std::string long_string(100, 'x');
+    EXPECT_GE(multi_index_lru::heap_bytes(long_string), 101U);
+
+    std::vector<std::string> strings{long_string, "sso"};
+    EXPECT_EQ(multi_index_lru::heap_bytes(strings),
+              strings.capacity() * sizeof(std::string) + multi_index_lru::heap_bytes(long_string));
+
+    const multi_index_lru::cold<std::string> cold_string(long_string);
+    EXPECT_EQ(heap_bytes(cold_string), sizeof(std::string) + multi_index_lru::heap_bytes(long_string));
+
+    EXPECT_FALSE(multi_index_lru::detail::has_heap_bytes<Point>);
+    EXPECT_TRUE(multi_index_lru::detail::has_heap_bytes<Document>);
+}
+
+TEST(MemoryUsageTest, StructureFollowsSizeAndBuckets) {
+    PointCache cache(100);
+    const auto empty = cache.memory_usage();
+    EXPECT_EQ(empty.node_values, 0U);
+    EXPECT_GT(empty.index_links, 0U);  // header node
+    EXPECT_GT(empty.buckets, 0U);
+    EXPECT_EQ(empty.payload, 0U);
+
+    for (int i = 0; i < 50; ++i) {
+        cache.emplace(Point{i, 1.0});
+    }
+    const auto full = cache.memory_usage();
+    EXPECT_EQ(full.node_values, 50 * sizeof(Point));
+    // Every node carries at least the LRU list's two links and the hash link
+    EXPECT_GE(full.index_links - empty.index_links, 50 * 3 * sizeof(void*));
+    EXPECT_EQ(full.payload, 0U);
+    EXPECT_EQ(full.total(), full.node_values + full.index_links + full.buckets + full.allocator_slack);
+
+    cache.reserve(10'000);
+    EXPECT_GT(cache.memory_usage().buckets, 10'000 * sizeof(void*));
+
+    cache.clear();
+    EXPECT_EQ(cache.memory_usage().node_values, 0U);
+}
+
+TEST(MemoryUsageTest, PayloadTrackedThroughEveryMutation) {
+    DocumentCache cache(10);
+    for (int i = 0; i < 15; ++i) {
+        cache.insert(make_document(i));  // evicts 0..4
+    }
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+
+    EXPECT_TRUE(cache.modify<IdTag>(7, [](Document& doc) { doc.tags.emplace_back(200, 'g'); }));
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+
+    // A collision on the unique index erases the modified element
+    EXPECT_FALSE(cache.modify<IdTag>(8, [](Document& doc) { doc.id = 9; }));
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+
+    // So does a throwing modifier
+    EXPECT_THROW(cache.modify<IdTag>(11, [](Document&) { throw std::runtime_error("modifier"); }),
+                 std::runtime_error);
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(11));
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+
+    EXPECT_TRUE(cache.erase<NameTag>(make_document(10).name));
+    EXPECT_TRUE(cache.evict_lru());
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+
+    auto node = cache.extract<IdTag>(12);
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+    DocumentCache other(10);
+    EXPECT_TRUE(other.insert(std::move(node)));
+    EXPECT_EQ(other.memory_usage().payload, recount_payload(other));
+
+    cache.set_capacity(2);
+    EXPECT_EQ(cache.memory_usage().payload, recount_payload(cache));
+    cache.clear();
+    EXPECT_EQ(cache.memory_usage().payload, 0U);
+}
+
+TEST(MemoryUsageTest, ExpirableContainerTracksExpiry) {
+    using Cache = multi_index_lru::ExpirableContainer<Document, DocumentIndices>;
+    Cache cache(10, std::chrono::milliseconds(20));
+    const auto document_bytes = heap_bytes(make_document(0));
+    for (int i = 0; i < 5; ++i) {
+        cache.insert(make_document(i));
+    }
+    EXPECT_EQ(cache.memory_usage().payload, 5 * document_bytes);
+    EXPECT_EQ(cache.memory_usage().node_values,
+              5 * sizeof(multi_index_lru::detail::TimestampedValue<Document>));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(cache.find<IdTag>(1), cache.end<IdTag>());  // erased as expired
+    EXPECT_EQ(cache.memory_usage().payload, 4 * document_bytes);
+    cache.cleanup_expired();
+    EXPECT_EQ(cache.memory_usage().payload, 0U);
+}
+
+TEST(MemoryUsageTest, WrappersSumTheirParts) {
+    multi_index_lru::ShardedContainer<Document, DocumentIndices> sharded(100, 4);
+    for (int i = 0; i < 20; ++i) {
+        sharded.insert(make_document(i));
+    }
+    sharded.insert_or_assign(make_document(3, 200));
+    sharded.reshard(2);
+    sharded.insert(make_document(50));
+    sharded.migrate_step(5);
+
+    EXPECT_EQ(sharded.memory_usage().node_values, 21 * sizeof(Document));
+    sharded.finish_migration();
+    const auto usage = sharded.memory_usage();
+    EXPECT_EQ(usage.node_values, 21 * sizeof(Document));
+    EXPECT_EQ(usage.payload, [&] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < sharded.shard_count(); ++i) {
+            total += sharded.with_shard(i, [](const auto& shard) { return recount_payload(shard); });
+        }
+        return total;
+    }());
+
+    using Lazy = multi_index_lru::LazyIndexedContainer<
+        Document,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                boost::multi_index::member<Document, int, &Document::id>>>,
+        multi_index_lru::lazy_indexed_by<
+            multi_index_lru::lazy_ordered_non_unique<
+                NameTag, boost::multi_index::member<Document, std::string, &Document::name>>>>;
+    Lazy lazy(10);
+    for (int i = 0; i < 5; ++i) {
+        lazy.insert(make_document(i));
+    }
+    const auto before_build = lazy.memory_usage();
+    lazy.build_indices();
+    EXPECT_GT(lazy.memory_usage().index_links, before_build.index_links);
+    EXPECT_TRUE(lazy.erase<NameTag>(make_document(2).name));
+    EXPECT_EQ(lazy.memory_usage().payload, recount_payload(lazy.get_cache()));
+}
+
+}  // namespace
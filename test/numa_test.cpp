@@ -0,0 +1,149 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/numa.hpp>
+#include <multi_index_lru/replicated_container.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct IdTag {};
+struct NameTag {};
+
+struct Item {
+    int id;
+    std::string name;
+};
+
+using Indices = boost::multi_index::indexed_by<
+    boost::multi_index::hashed_unique<
+        boost::multi_index::tag<IdTag>,
+        boost::multi_index::member<Item, int, &Item::id>>,
+    boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<NameTag>,
+        boost::multi_index::member<Item, std::string, &Item::name>>>;
+
+using NumaItemAllocator = multi_index_lru::NumaAllocator<Item>;
+
+TEST(NumaTest, NodeQueriesAreConsistent) {
+    const int nodes = multi_index_lru::numa::node_count();
+    ASSERT_GE(nodes, 1);
+    EXPECT_GE(multi_index_lru::numa::current_node(), 0);
+    EXPECT_LT(multi_index_lru::numa::current_node(), nodes);
+    EXPECT_EQ(multi_index_lru::numa::node_for_shard(static_cast<std::size_t>(nodes)), 0);
+}
+
+TEST(NumaTest, ArenaRecyclesBlocks) {
+    multi_index_lru::NumaArena arena(0, 4096);
+    void* a = arena.allocate(40, 8);
+    void* b = arena.allocate(40, 8);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(arena.reserved_bytes(), 4096U);
+
+    arena.deallocate(a, 40, 8);
+    EXPECT_EQ(arena.allocate(33, 8), a);  // same 48-byte size class
+
+    void* large = arena.allocate(8192, 8);
+    arena.deallocate(large, 8192, 8);
+    EXPECT_EQ(arena.reserved_bytes(), 4096U);
+}
+
+struct alignas(64) AlignedItem {
+    int id;
+};
+
+TEST(NumaTest, OverAlignedValuesAreAligned) {
+    multi_index_lru::NumaArena arena;
+    void* block = arena.allocate(48, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % 64, 0U);
+    arena.deallocate(block, 48, 64);
+
+    using AlignedIndices = boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<AlignedItem, int, &AlignedItem::id>>>;
+    multi_index_lru::Container<AlignedItem, AlignedIndices, multi_index_lru::NumaAllocator<AlignedItem>> cache(
+        100, multi_index_lru::NumaAllocator<AlignedItem>());
+    for (int i = 0; i < 200; ++i) {
+        cache.insert(AlignedItem{i});
+    }
+    EXPECT_EQ(cache.size(), 100U);
+    for (const auto& item : cache) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&item) % alignof(AlignedItem), 0U) << item.id;
+    }
+}
+
+TEST(NumaTest, ContainerWithNumaAllocator) {
+    multi_index_lru::Container<Item, Indices, NumaItemAllocator> cache(
+        3, NumaItemAllocator(multi_index_lru::numa::current_node()), true);
+    EXPECT_EQ(cache.get_allocator().node(), multi_index_lru::numa::current_node());
+
+    for (int i = 0; i < 10; ++i) {
+        cache.insert(Item{i, "item" + std::to_string(i)});
+    }
+    EXPECT_EQ(cache.size(), 3U);
+    EXPECT_TRUE(cache.contains<IdTag>(9));
+    EXPECT_FALSE(cache.contains<IdTag>(6));
+    EXPECT_GT(cache.get_allocator().arena()->reserved_bytes(), 0U);
+}
+
+TEST(NumaTest, ShardedContainerAllocatorPerShard) {
+    multi_index_lru::ShardedContainer<Item, Indices, NumaItemAllocator> cache(
+        100, 4, [](std::size_t shard) { return NumaItemAllocator(multi_index_lru::numa::node_for_shard(shard)); });
+
+    for (int i = 0; i < 50; ++i) {
+        cache.insert(Item{i, "item"});
+    }
+    EXPECT_EQ(cache.size(), 50U);
+    for (std::size_t shard = 0; shard < cache.shard_count(); ++shard) {
+        const int node = cache.with_shard(shard, [](const auto& c) { return c.get_allocator().node(); });
+        EXPECT_EQ(node, multi_index_lru::numa::node_for_shard(shard));
+    }
+}
+
+TEST(NumaTest, ReplicatedContainerKeepsReplicasIdentical) {
+    multi_index_lru::ReplicatedContainer<Item, Indices, NumaItemAllocator> cache(
+        2, 3, [](std::size_t replica) { return NumaItemAllocator(static_cast<int>(replica)); });
+    EXPECT_EQ(cache.replica_count(), 3U);
+    EXPECT_LT(cache.local_replica(), 3U);
+
+    EXPECT_TRUE(cache.insert(Item{1, "one"}));
+    EXPECT_TRUE(cache.emplace(Item{2, "two"}));
+    EXPECT_FALSE(cache.insert(Item{1, "one"}));  // refreshes 1 in every replica
+    cache.insert(Item{3, "three"});              // evicts 2 everywhere
+
+    EXPECT_EQ(cache.size(), 2U);
+    auto hit = cache.find_no_update<NameTag>(std::string("one"));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->id, 1);
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(2));
+
+    EXPECT_TRUE(cache.erase<IdTag>(3));
+    EXPECT_EQ(cache.size(), 1U);
+
+    EXPECT_THROW((multi_index_lru::ReplicatedContainer<Item, Indices>{10, 0}), std::invalid_argument);
+}
+
+}  // namespace
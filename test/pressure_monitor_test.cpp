@@ -0,0 +1,187 @@
+#include <multi_index_lru/container.hpp>
+#include <multi_index_lru/memory_budget.hpp>
+#include <multi_index_lru/pressure_monitor.hpp>
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+
+namespace {
+
+struct IdTag {};
+
+using IntIndices = boost::multi_index::indexed_by<
+    boost::multi_index::hashed_unique<
+        boost::multi_index::tag<IdTag>,
+        boost::multi_index::identity<int>>>;
+
+using IntCache = multi_index_lru::Container<int, IntIndices>;
+
+/// Fake cgroup v2 directory
+class FakeCgroup {
+public:
+    explicit FakeCgroup(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() / ("multi_index_lru_" + name)) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    ~FakeCgroup() { std::filesystem::remove_all(path_); }
+
+    void set(std::size_t current, const std::string& max, double avg10) const {
+        std::ofstream(path_ / "memory.current") << current << "\n";
+        std::ofstream(path_ / "memory.max") << max << "\n";
+        std::ofstream(path_ / "memory.pressure")
+            << "some avg10=" << avg10 << " avg60=0.00 avg300=0.00 total=123\n"
+            << "full avg10=0.00 avg60=0.00 avg300=0.00 total=45\n";
+    }
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+void fill(IntCache& cache, int count) {
+    for (int i = 0; i < count; ++i) {
+        cache.insert(i);
+    }
+}
+
+TEST(PressureMonitorTest, ReadsCgroupFiles) {
+    FakeCgroup cgroup("reads");
+    cgroup.set(900, "1000", 2.5);
+    multi_index_lru::PressureMonitor monitor({.cgroup_path = cgroup.path()});
+    auto reading = monitor.read();
+    EXPECT_EQ(reading.current_bytes, 900U);
+    EXPECT_EQ(reading.limit_bytes, 1000U);
+    EXPECT_DOUBLE_EQ(*reading.some_avg10, 2.5);
+    EXPECT_DOUBLE_EQ(*reading.usage_fraction(), 0.9);
+
+    cgroup.set(900, "max", 0.0);
+    reading = monitor.read();
+    EXPECT_FALSE(reading.limit_bytes.has_value());
+    EXPECT_FALSE(reading.usage_fraction().has_value());
+
+    multi_index_lru::PressureMonitor missing({.cgroup_path = cgroup.path() / "absent"});
+    reading = missing.read();
+    EXPECT_FALSE(reading.current_bytes.has_value());
+    EXPECT_FALSE(reading.some_avg10.has_value());
+}
+
+TEST(PressureMonitorTest, ShrinksUnderPressureAndRestores) {
+    FakeCgroup cgroup("shrinks");
+    multi_index_lru::PressureMonitor monitor({.cgroup_path = cgroup.path(),
+                                              .shrink_factor = 0.5,
+                                              .grow_step = 0.25,
+                                              .min_scale = 0.25,
+                                              .max_evictions_per_poll = 1000});
+    IntCache cache(1000);
+    fill(cache, 1000);
+    auto reg = monitor.add(cache);
+
+    cgroup.set(950, "1000", 0.0);  // usage above high_usage
+    monitor.poll();
+    EXPECT_DOUBLE_EQ(monitor.scale(), 0.5);
+    EXPECT_EQ(cache.capacity(), 500U);
+    EXPECT_EQ(cache.size(), 500U);
+    EXPECT_NE(cache.find<IdTag>(999), cache.end<IdTag>());  // most recent survive
+
+    cgroup.set(500, "1000", 50.0);  // PSI above high_pressure
+    monitor.poll();
+    monitor.poll();
+    EXPECT_DOUBLE_EQ(monitor.scale(), 0.25);  // clamped to min_scale
+    EXPECT_EQ(cache.capacity(), 250U);
+
+    cgroup.set(850, "1000", 0.0);  // between the thresholds: hold
+    monitor.poll();
+    EXPECT_DOUBLE_EQ(monitor.scale(), 0.25);
+
+    cgroup.set(100, "1000", 0.0);  // relieved: grow back step by step
+    monitor.poll();
+    EXPECT_EQ(cache.capacity(), 500U);
+    monitor.poll();
+    monitor.poll();
+    monitor.poll();
+    EXPECT_DOUBLE_EQ(monitor.scale(), 1.0);
+    EXPECT_EQ(cache.capacity(), 1000U);
+    EXPECT_EQ(cache.size(), 250U);  // capacity comes back, evicted elements do not
+}
+
+TEST(PressureMonitorTest, EvictionsPerPollAreBounded) {
+    FakeCgroup cgroup("bounded");
+    multi_index_lru::PressureMonitor monitor({.cgroup_path = cgroup.path(),
+                                              .shrink_factor = 0.1,
+                                              .min_scale = 0.1,
+                                              .max_evictions_per_poll = 300});
+    IntCache first(1000);
+    IntCache second(1000);
+    fill(first, 1000);
+    fill(second, 1000);
+    auto first_reg = monitor.add(first);
+    auto second_reg = monitor.add(second);
+
+    cgroup.set(0, "max", 90.0);
+    monitor.poll();
+    EXPECT_EQ(first.size() + second.size(), 2000U - 300U);
+    // The capacity follows the size down, so inserts cannot regrow it meanwhile
+    EXPECT_EQ(first.capacity(), first.size());
+    EXPECT_EQ(second.capacity(), 1000U);
+
+    while (monitor.apply() > 0) {
+    }
+    EXPECT_EQ(first.size(), 100U);
+    EXPECT_EQ(second.size(), 100U);
+    EXPECT_EQ(second.capacity(), 100U);
+}
+
+TEST(PressureMonitorTest, ScalesMemoryBudgetAndShardedContainer) {
+    FakeCgroup cgroup("budget");
+    multi_index_lru::PressureMonitor monitor({.cgroup_path = cgroup.path(), .shrink_factor = 0.5});
+
+    multi_index_lru::ShardedContainer<int, IntIndices> sharded(400, 4);
+    for (int i = 0; i < 400; ++i) {
+        sharded.insert(i);
+    }
+    IntCache cache(1000);
+    fill(cache, 1000);
+    multi_index_lru::MemoryBudget budget(cache.memory_usage().total());
+    auto budget_reg = budget.add(cache, [](int) { return std::chrono::steady_clock::time_point{}; });
+    auto sharded_reg = monitor.add(sharded);
+    auto monitor_reg = monitor.add(budget);
+    EXPECT_EQ(monitor.cache_count(), 2U);
+
+    const auto full_budget = budget.budget();
+    cgroup.set(0, "max", 20.0);
+    monitor.poll();
+    EXPECT_EQ(budget.budget(), full_budget / 2);
+    EXPECT_LE(budget.usage(), budget.budget());
+    EXPECT_LT(cache.size(), 1000U);
+    EXPECT_EQ(sharded.capacity(), 200U);
+    EXPECT_LE(sharded.size(), 200U);
+
+    sharded_reg.reset();
+    EXPECT_EQ(monitor.cache_count(), 1U);
+}
+
+TEST(PressureMonitorTest, ParameterValidation) {
+    using Options = multi_index_lru::PressureMonitorOptions;
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.high_usage = 0.5, .low_usage = 0.6}),
+                 std::invalid_argument);
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.high_pressure = 1.0, .low_pressure = 2.0}),
+                 std::invalid_argument);
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.shrink_factor = 1.0}), std::invalid_argument);
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.min_scale = 0.0}), std::invalid_argument);
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.grow_step = 0.0}), std::invalid_argument);
+    EXPECT_THROW(multi_index_lru::PressureMonitor(Options{.max_evictions_per_poll = 0}), std::invalid_argument);
+}
+
+}  // namespace
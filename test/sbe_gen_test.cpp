@@ -0,0 +1,68 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated from example/schemas/market_cache.xml by test/CMakeLists.txt
+#include <quote_cache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using Quote = market_cache_gen::quote_cache;
+
+std::vector<uint8_t> EncodeQuote(std::uint16_t template_id, std::uint32_t security_id) {
+    std::vector<uint8_t> message(14, 0);
+    message[0] = 6;                         // blockLength
+    message[2] = Quote::message_template_id;
+    message[8] = static_cast<uint8_t>(template_id & 0xFFU);
+    message[9] = static_cast<uint8_t>(template_id >> 8U);
+    for (std::size_t i = 0; i < 4; ++i) {
+        message[10 + i] = static_cast<uint8_t>(security_id >> (8U * i));
+    }
+    return message;
+}
+
+TEST(SbeGenTest, OffsetsFollowTheSchema) {
+    static_assert(Quote::header_size == 8);
+    static_assert(Quote::message_template_id == 2);
+    static_assert(Quote::template_id_field::offset == 8);
+    static_assert(Quote::security_id_field::offset == 10);
+    static_assert(std::is_same_v<Quote::entry_type::keys_type, std::tuple<std::uint32_t, std::uint16_t>>);
+    static_assert(Quote::builder_type::min_message_size == 14);
+}
+
+TEST(SbeGenTest, GeneratedCacheTypesWork) {
+    Quote::builder_type builder;
+    Quote::cache_type cache(10);
+    cache.insert(builder.build(EncodeQuote(101, 5'001)));
+    cache.insert(builder.build(EncodeQuote(101, 5'002)));
+
+    auto it = cache.find<Quote::security_id_tag>(5'002U);
+    ASSERT_NE(it, cache.end<Quote::security_id_tag>());
+    EXPECT_EQ(std::get<1>(it->keys), 101);
+
+    auto [first, last] = cache.equal_range_no_update<Quote::template_id_tag>(std::uint16_t{101});
+    EXPECT_EQ(std::distance(first, last), 2);
+
+    Quote::expirable_cache_type expirable(10, std::chrono::hours(1));
+    expirable.insert(builder.build(EncodeQuote(7, 42)));
+    EXPECT_TRUE(expirable.contains<Quote::security_id_tag>(42U));
+}
+
+}  // namespace
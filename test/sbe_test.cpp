@@ -15,6 +15,7 @@
 #include <multi_index_lru/container.hpp>
 #include <multi_index_lru/expirable_container.hpp>
 #include <multi_index_lru/sbe_cache.hpp>
+#include <multi_index_lru/sbe_fixed.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -22,12 +23,19 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <span>
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace {
 
 struct MockSbeView {
@@ -152,4 +160,190 @@ TEST(SbeCacheTest, ExpirableContainerWorksWithTimestampedSbeKeys) {
     EXPECT_EQ(std::get<0>(it->keys), 11);
 }
 
+TEST(SbeCacheTest, MemoryUsageCountsOwnedBuffer) {
+    auto builder = multi_index_lru::make_sbe_entry_builder<Entry>(
+        MakeMockSbeView,
+        multi_index_lru::make_sbe_field<std::uint16_t>(&MockSbeView::template_id),
+        multi_index_lru::make_sbe_field<std::uint32_t>(&MockSbeView::security_id));
+
+    Cache cache(3);
+    cache.emplace(builder.build(MakePayload(7, 1001)));
+    cache.emplace(builder.build(MakePayload(8, 1002)));
+
+    std::size_t capacity = 0;
+    for (const auto& entry : cache) {
+        capacity += entry.data.capacity();
+    }
+    EXPECT_NE(cache.memory_usage().payload, 0U);
+    EXPECT_EQ(cache.memory_usage().payload, capacity);
+
+    ExpirableCache expirable(2, std::chrono::hours(1));
+    expirable.emplace(builder.build(MakePayload(11, 2001)));
+    EXPECT_EQ(expirable.memory_usage().payload,
+              expirable.find_no_update<SecurityTag>(2001U)->data.capacity());
+}
+
+TEST(SbeCacheTest, UpdatePayloadInPlace) {
+    auto builder = multi_index_lru::make_sbe_entry_builder<Entry>(
+        MakeMockSbeView,
+        multi_index_lru::make_sbe_field<std::uint16_t>(&MockSbeView::template_id),
+        multi_index_lru::make_sbe_field<std::uint32_t>(&MockSbeView::security_id));
+
+    auto with_price = [](std::uint16_t template_id, std::uint32_t security_id) {
+        auto payload = MakePayload(template_id, security_id);
+        payload.push_back(0);  // non-key "price" byte
+        return payload;
+    };
+
+    Cache cache(2);
+    cache.emplace(builder.build(with_price(7, 1001)));
+    cache.emplace(builder.build(with_price(8, 1002)));
+    const auto* stored = cache.find_no_update<SecurityTag>(1001U)->data.data();
+
+    using multi_index_lru::SbeUpdateResult;
+    auto set_price = [](std::span<uint8_t> bytes) { bytes[6] = 42; };
+    EXPECT_EQ(multi_index_lru::update_payload<SecurityTag>(cache, 1001U, builder, set_price),
+              SbeUpdateResult::updated);
+    EXPECT_EQ(multi_index_lru::update_payload<SecurityTag>(cache, 999U, builder, set_price),
+              SbeUpdateResult::not_found);
+
+    auto it = cache.find_no_update<SecurityTag>(1001U);
+    ASSERT_NE(it, cache.end<SecurityTag>());
+    EXPECT_EQ(it->data[6], 42);
+    EXPECT_EQ(it->data.data(), stored);  // same bytes, no reinsert
+
+    // Writing a key field re-indexes the entry
+    EXPECT_EQ(multi_index_lru::update_payload<TemplateTag>(cache, std::uint16_t{7}, builder,
+                  [](std::span<uint8_t> bytes) { bytes[0] = 9; }),
+              SbeUpdateResult::rekeyed);
+    EXPECT_FALSE(cache.contains_no_update<TemplateTag>(std::uint16_t{7}));
+    EXPECT_TRUE(cache.contains_no_update<TemplateTag>(std::uint16_t{9}));
+
+    // Colliding with another entry's key removes the updated entry
+    EXPECT_EQ(multi_index_lru::update_payload<TemplateTag>(cache, std::uint16_t{9}, builder,
+                  [](std::span<uint8_t> bytes) { bytes[0] = 8; }),
+              SbeUpdateResult::erased);
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_TRUE(cache.contains_no_update<SecurityTag>(1002U));
+}
+
+TEST(SbeCacheTest, UpdatePayloadInExpirableContainer) {
+    auto builder = multi_index_lru::make_sbe_entry_builder<Entry>(
+        MakeMockSbeView,
+        multi_index_lru::make_sbe_field<std::uint16_t>(&MockSbeView::template_id),
+        multi_index_lru::make_sbe_field<std::uint32_t>(&MockSbeView::security_id));
+
+    ExpirableCache cache(2, std::chrono::hours(1));
+    auto payload = MakePayload(11, 2001);
+    payload.push_back(0);
+    cache.emplace(builder.build(payload));
+
+    EXPECT_EQ(multi_index_lru::update_payload<SecurityTag>(cache, 2001U, builder,
+                  [](std::span<uint8_t> bytes) { bytes[6] = 5; }),
+              multi_index_lru::SbeUpdateResult::updated);
+    auto it = cache.find<SecurityTag>(2001U);
+    ASSERT_NE(it, cache.end<SecurityTag>());
+    EXPECT_EQ(it->data[6], 5);
+}
+
+// Layout of market_cache.xml's quote: 8-byte header, template_id at 8, security_id at 10
+using QuoteTemplateId = multi_index_lru::sbe_fixed_field<std::uint16_t, 8>;
+using QuoteSecurityId = multi_index_lru::sbe_fixed_field<std::uint32_t, 10>;
+using FixedBuilder = multi_index_lru::FixedSbeEntryBuilder<Entry, QuoteTemplateId, QuoteSecurityId>;
+
+std::vector<uint8_t> MakeQuote(std::uint16_t template_id, std::uint32_t security_id) {
+    std::vector<uint8_t> message(multi_index_lru::sbe_message_header_size, 0);
+    auto body = MakePayload(template_id, security_id);
+    message.insert(message.end(), body.begin(), body.end());
+    return message;
+}
+
+TEST(SbeFixedTest, BuilderReadsFixedOffsets) {
+    FixedBuilder builder;
+    EXPECT_EQ(FixedBuilder::min_message_size, 14U);
+
+    auto entry = builder.build(MakeQuote(7, 0x01020304));
+    EXPECT_EQ(std::get<0>(entry.keys), 7);
+    EXPECT_EQ(std::get<1>(entry.keys), 0x01020304U);
+    EXPECT_EQ(entry.raw_data().size(), 14U);
+
+    Cache cache(3);
+    cache.insert(builder.build(MakeQuote(8, 1002)));
+    EXPECT_TRUE(cache.contains<SecurityTag>(1002U));
+
+    const std::vector<uint8_t> truncated(13, 0);
+    EXPECT_THROW(builder.build(truncated), std::out_of_range);
+}
+
+TEST(SbeFixedTest, BatchExtractionMatchesScalar) {
+    // Messages of different lengths packed into one buffer
+    std::vector<uint8_t> buffer;
+    std::vector<std::uint32_t> offsets;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        offsets.push_back(static_cast<std::uint32_t>(buffer.size()));
+        auto quote = MakeQuote(static_cast<std::uint16_t>(i * 31U), i * 2654435761U);
+        buffer.insert(buffer.end(), quote.begin(), quote.end());
+        buffer.resize(buffer.size() + i % 5);
+    }
+
+    FixedBuilder builder;
+    std::vector<Entry::keys_type> keys(offsets.size());
+    builder.extract_keys_batch(buffer, offsets, keys);
+
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        const auto message = std::span<const uint8_t>(buffer).subspan(offsets[i]);
+        ASSERT_EQ(keys[i], builder.extract_keys(message)) << "message " << i;
+        EXPECT_EQ(std::get<1>(keys[i]), static_cast<std::uint32_t>(i * 2654435761U));
+    }
+
+    // Column extraction (gathers when built with AVX2) agrees with the tuples
+    std::vector<std::uint16_t> template_ids(offsets.size());
+    std::vector<std::uint32_t> security_ids(offsets.size());
+    builder.extract_column<0>(buffer, offsets, template_ids);
+    builder.extract_column<1>(buffer, offsets, security_ids);
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT_EQ(template_ids[i], std::get<0>(keys[i])) << "message " << i;
+        ASSERT_EQ(security_ids[i], std::get<1>(keys[i])) << "message " << i;
+    }
+
+    // A message whose key fields run past the buffer is rejected
+    offsets.push_back(static_cast<std::uint32_t>(buffer.size() - 10));
+    keys.resize(offsets.size());
+    security_ids.resize(offsets.size());
+    EXPECT_THROW(builder.extract_keys_batch(buffer, offsets, keys), std::out_of_range);
+    EXPECT_THROW(builder.extract_column<1>(buffer, offsets, security_ids), std::out_of_range);
+}
+
+#if defined(__linux__)
+TEST(SbeFixedTest, ColumnExtractionBeyondTwoGibibytes) {
+    // Offsets past INT32_MAX do not fit signed 32-bit gather indices; only
+    // the touched pages of the mapping are ever allocated
+    constexpr std::size_t size = std::size_t{3} << 30;
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED) {
+        GTEST_SKIP() << "cannot map 3 GiB of address space";
+    }
+    const std::span<uint8_t> buffer(static_cast<uint8_t*>(mapping), size);
+
+    std::vector<std::uint32_t> offsets;
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        offsets.push_back(i * (std::uint32_t{3} << 26) + i);  // up to ~2.8 GiB
+        const auto quote = MakeQuote(static_cast<std::uint16_t>(i), 1000 + i);
+        std::copy(quote.begin(), quote.end(), buffer.begin() + offsets.back());
+    }
+
+    FixedBuilder builder;
+    std::vector<std::uint16_t> template_ids(offsets.size());
+    std::vector<std::uint32_t> security_ids(offsets.size());
+    builder.extract_column<0>(buffer, offsets, template_ids);
+    builder.extract_column<1>(buffer, offsets, security_ids);
+    for (std::uint32_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(template_ids[i], i) << "message " << i;
+        EXPECT_EQ(security_ids[i], 1000 + i) << "message " << i;
+    }
+    munmap(mapping, size);
+}
+#endif
+
 }  // namespace
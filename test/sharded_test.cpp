@@ -0,0 +1,395 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/sharded_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct IdTag {};
+struct NameTag {};
+
+struct Item {
+    int id;
+    std::string name;
+};
+
+using ShardedCache = multi_index_lru::ShardedContainer<
+    Item,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<Item, int, &Item::id>>,
+        boost::multi_index::ordered_non_unique<
+            boost::multi_index::tag<NameTag>,
+            boost::multi_index::member<Item, std::string, &Item::name>>>>;
+
+TEST(ShardedContainerTest, BasicOperations) {
+    ShardedCache cache(100, 4);
+    EXPECT_EQ(cache.shard_count(), 4U);
+    EXPECT_EQ(cache.capacity(), 100U);
+
+    EXPECT_TRUE(cache.insert(Item{1, "one"}));
+    EXPECT_TRUE(cache.emplace(Item{2, "two"}));
+    EXPECT_FALSE(cache.insert(Item{1, "uno"}));
+    EXPECT_EQ(cache.size(), 2U);
+
+    auto hit = cache.find<IdTag>(1);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->name, "one");
+    EXPECT_FALSE(cache.find<IdTag>(3).has_value());
+
+    // Secondary index lookups fan out over all shards
+    auto by_name = cache.find_no_update<NameTag>(std::string("two"));
+    ASSERT_TRUE(by_name.has_value());
+    EXPECT_EQ(by_name->id, 2);
+
+    EXPECT_TRUE(cache.contains<IdTag>(2));
+    EXPECT_TRUE(cache.erase<NameTag>(std::string("two")));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(2));
+    EXPECT_TRUE(cache.erase<IdTag>(1));
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(ShardedContainerTest, InsertOrAssignReplaces) {
+    ShardedCache cache(2, 1);
+    const auto version = cache.shard_version(0);
+
+    EXPECT_TRUE(cache.insert_or_assign(Item{1, "one"}));
+    EXPECT_TRUE(cache.insert_or_assign(Item{2, "two"}));
+    EXPECT_FALSE(cache.insert_or_assign(Item{1, "uno"}));
+    EXPECT_GT(cache.shard_version(0), version);
+
+    auto hit = cache.find_no_update<IdTag>(1);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->name, "uno");
+    EXPECT_TRUE(cache.contains_no_update<NameTag>(std::string("uno")));
+    EXPECT_FALSE(cache.contains_no_update<NameTag>(std::string("one")));
+
+    // The replaced element became most recent, so 2 is evicted
+    cache.insert_or_assign(Item{3, "three"});
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(2));
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(1));
+
+    // Hits do not change the version
+    const auto before_hit = cache.shard_version(0);
+    EXPECT_TRUE(cache.contains<IdTag>(3));
+    EXPECT_EQ(cache.shard_version(0), before_hit);
+}
+
+TEST(ShardedContainerTest, VisitAvoidsCopy) {
+    ShardedCache cache(10, 2);
+    cache.insert(Item{7, "seven"});
+
+    std::string seen;
+    EXPECT_TRUE(cache.visit<IdTag>(7, [&seen](const Item& item) { seen = item.name; }));
+    EXPECT_EQ(seen, "seven");
+    EXPECT_FALSE(cache.visit_no_update<IdTag>(8, [](const Item&) { FAIL(); }));
+}
+
+TEST(ShardedContainerTest, CapacityIsSplitAcrossShards) {
+    ShardedCache cache(64, 4);
+    for (int i = 0; i < 1000; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+    EXPECT_LE(cache.size(), 64U);
+
+    for (std::size_t i = 0; i < cache.shard_count(); ++i) {
+        cache.with_shard(i, [](auto& shard) {
+            EXPECT_EQ(shard.capacity(), 16U);
+            EXPECT_LE(shard.size(), 16U);
+        });
+    }
+
+    cache.set_capacity(8);
+    EXPECT_EQ(cache.capacity(), 8U);
+    EXPECT_LE(cache.size(), 8U);
+}
+
+TEST(ShardedContainerTest, UnevenCapacityAddsUpToTheTotal) {
+    ShardedCache cache(10, 4);
+    const auto total_shard_capacity = [&cache] {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < cache.shard_count(); ++i) {
+            cache.with_shard(i, [&](auto& shard) { total += shard.capacity(); });
+        }
+        return total;
+    };
+    EXPECT_EQ(total_shard_capacity(), 10U);
+    for (int i = 0; i < 1000; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+    EXPECT_EQ(cache.size(), 10U);
+
+    cache.set_capacity(7);
+    EXPECT_EQ(total_shard_capacity(), 7U);
+    EXPECT_EQ(cache.size(), 7U);
+}
+
+TEST(ShardedContainerTest, ValuesRouteToStableShard) {
+    ShardedCache cache(100, 8);
+    Item item{42, "answer"};
+    cache.insert(item);
+
+    const auto index = cache.shard_index(item);
+    cache.with_shard(index, [](auto& shard) {
+        EXPECT_TRUE(shard.template contains_no_update<IdTag>(42));
+    });
+}
+
+TEST(ShardedContainerTest, GrowthRehashIsDeferredPerShard) {
+    ShardedCache cache(400, 4, true);
+    for (std::size_t i = 0; i < cache.shard_count(); ++i) {
+        cache.with_shard(i, [](auto& shard) {
+            EXPECT_GE(shard.template get_index<IdTag>().bucket_count(), 100U);
+        });
+    }
+
+    cache.set_capacity(4000);
+    EXPECT_EQ(cache.pending_rehashes(), 4U);
+
+    // An insert rehashes only the shard it lands in
+    cache.insert(Item{1, "one"});
+    EXPECT_EQ(cache.pending_rehashes(), 3U);
+
+    while (cache.rehash_step()) {
+    }
+    EXPECT_EQ(cache.pending_rehashes(), 0U);
+    for (std::size_t i = 0; i < cache.shard_count(); ++i) {
+        cache.with_shard(i, [](auto& shard) {
+            EXPECT_GE(shard.template get_index<IdTag>().bucket_count(), 1000U);
+        });
+    }
+}
+
+TEST(ShardedContainerTest, ParameterValidation) {
+    EXPECT_THROW((ShardedCache{0, 4}), std::invalid_argument);
+    EXPECT_THROW((ShardedCache{10, 0}), std::invalid_argument);
+
+    ShardedCache cache(10, 2);
+    EXPECT_THROW(cache.set_capacity(0), std::invalid_argument);
+    EXPECT_THROW(cache.reshard(0), std::invalid_argument);
+    EXPECT_THROW(cache.migrate_step(0), std::invalid_argument);
+}
+
+TEST(ShardedContainerTest, ReshardMigratesIncrementally) {
+    ShardedCache cache(1000, 4);
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+
+    cache.reshard(8);
+    EXPECT_EQ(cache.shard_count(), 8U);
+    EXPECT_TRUE(cache.migrating());
+
+    // Everything stays visible while the elements are still in the old shards
+    EXPECT_EQ(cache.size(), 100U);
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(5));
+    EXPECT_TRUE(cache.contains<NameTag>(std::string("6")));
+    EXPECT_FALSE(cache.insert(Item{7, "again"}));  // refreshes the migrated element
+    EXPECT_TRUE(cache.erase<IdTag>(8));
+    EXPECT_TRUE(cache.erase<NameTag>(std::string("9")));
+
+    EXPECT_TRUE(cache.migrate_step(10));
+    EXPECT_EQ(cache.size(), 98U);
+    cache.finish_migration();
+    EXPECT_FALSE(cache.migrating());
+    EXPECT_FALSE(cache.migrate_step(10));
+    EXPECT_EQ(cache.size(), 98U);
+
+    for (int i = 0; i < 100; ++i) {
+        const Item item{i, std::to_string(i)};
+        const bool found = cache.with_shard(cache.shard_index(item), [i](const auto& shard) {
+            return shard.template contains_no_update<IdTag>(i);
+        });
+        EXPECT_EQ(found, i != 8 && i != 9) << i;
+    }
+}
+
+TEST(ShardedContainerTest, ReshardKeepsCapacityAndRecentElements) {
+    ShardedCache cache(64, 4);
+    for (int i = 0; i < 1000; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+    const auto version = cache.shard_version(3);
+
+    cache.reshard(2);
+    EXPECT_GT(cache.shard_version(1), version);
+    EXPECT_EQ(cache.shard_version(3), std::numeric_limits<std::uint64_t>::max());
+
+    // A new shard fills up with fresh inserts before the migration runs
+    for (int i = 1000; i < 1100; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+    cache.finish_migration();
+    EXPECT_EQ(cache.capacity(), 64U);
+    EXPECT_LE(cache.size(), 64U);
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(1099));
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(999));
+
+    // Resharding to the same count is a no-op
+    cache.reshard(2);
+    EXPECT_FALSE(cache.migrating());
+}
+
+TEST(ShardedContainerTest, ReshardFreesDrainedShards) {
+    ShardedCache cache(1000, 4);
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(Item{i, std::to_string(i)});
+    }
+    for (std::size_t shards = 1; shards <= 50; ++shards) {
+        cache.reshard(shards % 8 + 1);
+        cache.finish_migration();
+    }
+    EXPECT_EQ(cache.reclaim(), 0U);
+
+    // A thread inside an operation that may still see the old shards keeps
+    // them alive. The cache is empty, so the migration needs no lock the
+    // reader holds.
+    {
+        ShardedCache empty(1000, 4);
+        empty.reshard(8);
+        std::atomic<bool> entered{false};
+        std::atomic<bool> release{false};
+        std::thread reader([&] {
+            empty.with_shard(0, [&](const auto&) {
+                entered.store(true);
+                while (!release.load()) {
+                    std::this_thread::yield();
+                }
+            });
+        });
+        while (!entered.load()) {
+            std::this_thread::yield();
+        }
+        empty.finish_migration();
+        EXPECT_EQ(empty.reclaim(), 1U);
+        release.store(true);
+        reader.join();
+        EXPECT_EQ(empty.reclaim(), 0U);
+    }
+    EXPECT_EQ(cache.size(), 100U);
+
+    // Indices of a larger layout are out of range after shrinking
+    cache.reshard(2);
+    EXPECT_THROW(cache.with_shard(3, [](const auto&) {}), std::out_of_range);
+    EXPECT_EQ(cache.shard_version(3), std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST(ShardedContainerTest, ManyMoreThreadsThanEpochSlots) {
+    // Every thread is alive until all have inserted and found their element
+    constexpr int kThreads = 300;
+    ShardedCache cache(10'000, 4);
+    std::atomic<int> done{0};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&cache, &done, &failures, t] {
+            try {
+                cache.insert(Item{t, std::to_string(t)});
+                if (!cache.find<IdTag>(t)) {
+                    failures.fetch_add(1);
+                }
+            } catch (...) {
+                failures.fetch_add(1);
+            }
+            done.fetch_add(1);
+            while (done.load() < kThreads) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(cache.size(), static_cast<std::size_t>(kThreads));
+}
+
+TEST(ShardedContainerTest, ConcurrentAccessDuringReshard) {
+    ShardedCache cache(100'000, 4);
+    constexpr int kKeys = 2000;
+    for (int id = 0; id < kKeys; ++id) {
+        cache.insert(Item{id, std::to_string(id)});
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&cache, &done, &misses, t] {
+            for (int round = 0; !done.load(std::memory_order_relaxed); ++round) {
+                const int id = (round * 7 + t) % kKeys;
+                if (t == 0) {
+                    cache.insert_or_assign(Item{id, std::to_string(id)});
+                } else if (!cache.contains<IdTag>(id)) {
+                    misses.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (std::size_t shards : {7U, 2U, 16U}) {
+        cache.reshard(shards);
+        while (cache.migrate_step(64)) {
+        }
+    }
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_EQ(cache.size(), static_cast<std::size_t>(kKeys));
+}
+
+TEST(ShardedContainerTest, ConcurrentInsertAndFind) {
+    ShardedCache cache(10'000, 8);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> hits{0};
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&cache, &hits, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                const int id = t * kPerThread + i;
+                cache.insert(Item{id, std::to_string(id)});
+                if (cache.find<IdTag>(id)) {
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(hits.load(), kThreads * kPerThread);
+    EXPECT_EQ(cache.size(), static_cast<std::size_t>(kThreads * kPerThread));
+}
+
+}  // namespace
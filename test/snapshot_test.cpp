@@ -0,0 +1,128 @@
+// Copyright 2026 multi_index_lru contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <multi_index_lru/snapshot_container.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct SymbolTag {};
+struct IdTag {};
+
+struct Instrument {
+    std::string symbol;
+    int id;
+    double tick_size;
+};
+
+using InstrumentSnapshots = multi_index_lru::SnapshotContainer<
+    Instrument,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::tag<SymbolTag>,
+            boost::multi_index::member<Instrument, std::string, &Instrument::symbol>>,
+        boost::multi_index::ordered_unique<
+            boost::multi_index::tag<IdTag>,
+            boost::multi_index::member<Instrument, int, &Instrument::id>>>>;
+
+TEST(SnapshotContainerTest, UpdateAndPublish) {
+    InstrumentSnapshots instruments(100);
+    EXPECT_EQ(instruments.size(), 0U);
+
+    instruments.update([](auto& snapshot) {
+        snapshot.insert(Instrument{"AAPL", 1, 0.01});
+        snapshot.insert(Instrument{"MSFT", 2, 0.01});
+    });
+
+    auto hit = instruments.find_no_update<SymbolTag>(std::string("AAPL"));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->id, 1);
+    EXPECT_TRUE(instruments.contains_no_update<IdTag>(2));
+    EXPECT_FALSE(instruments.contains_no_update<IdTag>(3));
+
+    InstrumentSnapshots::snapshot_type next(100);
+    next.insert(Instrument{"GOOG", 3, 0.05});
+    instruments.publish(std::move(next));
+
+    EXPECT_EQ(instruments.size(), 1U);
+    EXPECT_FALSE(instruments.contains_no_update<SymbolTag>(std::string("AAPL")));
+    EXPECT_TRUE(instruments.contains_no_update<SymbolTag>(std::string("GOOG")));
+}
+
+TEST(SnapshotContainerTest, ActiveReaderKeepsOldSnapshotAlive) {
+    InstrumentSnapshots instruments(100);
+    instruments.update([](auto& snapshot) { snapshot.insert(Instrument{"AAPL", 1, 0.01}); });
+    instruments.reclaim();
+
+    instruments.read([&instruments](const auto& snapshot) {
+        // Publishing while this thread reads must not free the snapshot it holds
+        instruments.update([](auto& next) { next.insert(Instrument{"MSFT", 2, 0.01}); });
+        EXPECT_EQ(instruments.retired_count(), 1U);
+
+        EXPECT_EQ(snapshot.size(), 1U);
+        EXPECT_TRUE(snapshot.template contains_no_update<SymbolTag>(std::string("AAPL")));
+        EXPECT_FALSE(snapshot.template contains_no_update<SymbolTag>(std::string("MSFT")));
+    });
+
+    EXPECT_EQ(instruments.reclaim(), 0U);
+    EXPECT_EQ(instruments.size(), 2U);
+}
+
+TEST(SnapshotContainerTest, ConcurrentReadersSeeConsistentVersions) {
+    InstrumentSnapshots instruments(1000);
+    constexpr int kVersions = 200;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                instruments.read([&](const auto& snapshot) {
+                    // Every published version holds ids 0..n-1 for some n
+                    const auto n = static_cast<int>(snapshot.size());
+                    if (n > 0 && !snapshot.template contains_no_update<IdTag>(n - 1)) {
+                        inconsistent.fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+    }
+
+    for (int i = 0; i < kVersions; ++i) {
+        instruments.update([i](auto& snapshot) {
+            snapshot.insert(Instrument{std::to_string(i), i, 0.01});
+        });
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_EQ(instruments.size(), static_cast<std::size_t>(kVersions));
+    EXPECT_EQ(instruments.reclaim(), 0U);
+}
+
+}  // namespace
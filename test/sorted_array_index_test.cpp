@@ -0,0 +1,135 @@
+#include <multi_index_lru/sorted_array_index.hpp>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+namespace {
+
+struct Quote {
+    int id;
+    int price;
+};
+
+using PriceKey = boost::multi_index::member<Quote, int, &Quote::price>;
+using PriceIndex = multi_index_lru::SortedArrayIndex<Quote, PriceKey>;
+
+std::vector<int> prices(std::pair<PriceIndex::iterator, PriceIndex::iterator> range) {
+    std::vector<int> result;
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(it->price);
+    }
+    return result;
+}
+
+TEST(SortedArrayIndexTest, DeltaAndTombstonesMergeOnLookup) {
+    std::vector<Quote> quotes{{1, 30}, {2, 10}, {3, 20}, {4, 20}};
+    PriceIndex index;
+    index.build(quotes);
+
+    Quote late{5, 15};
+    index.insert(&late);
+    index.erase(&quotes[2]);
+    EXPECT_EQ(index.delta_size(), 1U);
+    EXPECT_EQ(index.tombstone_count(), 1U);
+    EXPECT_EQ(index.size(), 4U);
+
+    EXPECT_EQ(prices({index.begin(), index.end()}), (std::vector<int>{10, 15, 20, 30}));
+    EXPECT_EQ(prices(index.range(12, 30)), (std::vector<int>{15, 20}));
+    EXPECT_EQ(index.find(20), &quotes[3]);
+    EXPECT_EQ(index.find(15), &late);
+    EXPECT_EQ(index.find(25), nullptr);
+    EXPECT_EQ(index.count(20), 1U);
+
+    index.compact();
+    EXPECT_EQ(index.delta_size(), 0U);
+    EXPECT_EQ(index.tombstone_count(), 0U);
+    EXPECT_EQ(prices({index.begin(), index.end()}), (std::vector<int>{10, 15, 20, 30}));
+}
+
+TEST(SortedArrayIndexTest, MatchesMultimapUnderRandomUpdates) {
+    std::vector<Quote> quotes(2000);
+    for (int i = 0; i < 2000; ++i) {
+        quotes[static_cast<std::size_t>(i)] = Quote{i, 0};
+    }
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> price(0, 200);
+    std::vector<bool> indexed(quotes.size(), false);
+    std::multimap<int, const Quote*> expected;
+    PriceIndex index;
+
+    for (int step = 0; step < 20000; ++step) {
+        auto& quote = quotes[rng() % quotes.size()];
+        const auto slot = static_cast<std::size_t>(quote.id);
+        if (indexed[slot]) {
+            index.erase(&quote);
+            auto [first, last] = expected.equal_range(quote.price);
+            for (auto it = first; it != last; ++it) {
+                if (it->second == &quote) {
+                    expected.erase(it);
+                    break;
+                }
+            }
+            indexed[slot] = false;
+        } else {
+            quote.price = price(rng);
+            index.insert(&quote);
+            expected.emplace(quote.price, &quote);
+            indexed[slot] = true;
+        }
+    }
+
+    ASSERT_EQ(index.size(), expected.size());
+    for (int lower = 0; lower <= 200; lower += 25) {
+        auto [first, last] = index.range(lower, lower + 30);
+        EXPECT_EQ(static_cast<std::size_t>(std::distance(first, last)),
+                  static_cast<std::size_t>(std::distance(expected.lower_bound(lower),
+                                                         expected.lower_bound(lower + 30))));
+        int previous = lower;
+        for (auto it = first; it != last; ++it) {
+            EXPECT_LE(previous, it->price);
+            previous = it->price;
+        }
+    }
+}
+
+TEST(SortedArrayIndexTest, LazySortedArrayInContainer) {
+    struct IdTag {};
+    struct PriceTag {};
+    using Quotes = multi_index_lru::LazyIndexedContainer<
+        Quote,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                boost::multi_index::member<Quote, int, &Quote::id>>>,
+        multi_index_lru::lazy_indexed_by<
+            multi_index_lru::lazy_sorted_array<PriceTag, PriceKey>>>;
+
+    Quotes quotes(3);
+    quotes.build_index<PriceTag>();
+    quotes.emplace(Quote{1, 100});
+    quotes.emplace(Quote{2, 90});
+    quotes.emplace(Quote{3, 110});
+    quotes.emplace(Quote{4, 95});  // evicts id=1
+
+    auto [first, last] = quotes.range_no_update<PriceTag>(90, 101);
+    std::vector<int> ids;
+    for (auto it = first; it != last; ++it) {
+        ids.push_back(it->id);
+    }
+    EXPECT_EQ(ids, (std::vector<int>{2, 4}));
+
+    EXPECT_TRUE(quotes.modify<IdTag>(2, [](Quote& quote) { quote.price = 120; }));
+    EXPECT_EQ(quotes.find<PriceTag>(120)->id, 2);
+    EXPECT_FALSE(quotes.contains_no_update<PriceTag>(90));
+    EXPECT_TRUE(quotes.erase<PriceTag>(110));
+    EXPECT_EQ(quotes.get_lazy_index<PriceTag>().size(), 2U);
+}
+
+}  // namespace
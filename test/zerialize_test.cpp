@@ -9,6 +9,7 @@
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 
+#include <cstddef>
 #include <cstring>
 #include <span>
 #include <string>
@@ -552,4 +553,110 @@ TEST(ZerializeCacheTest, SetCapacity) {
     EXPECT_EQ(cache.capacity(), 2);
 }
 
+// =============================================================================
+// Test: Memory accounting
+// =============================================================================
+
+TEST(ZerializeCacheTest, MemoryUsageCountsOwnedBuffer) {
+    using namespace multi_index_lru;
+
+    struct IdTag {};
+    using Entry = EntryWithKeys_t<int64_t>;
+    using Cache = Container<
+        Entry,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                key<0, Entry>
+            >
+        >
+    >;
+
+    auto builder = make_entry_builder<Entry>(int64_field("id"));
+
+    Cache cache(10);
+    cache.emplace(builder.build<MockDeserializer>(make_mock_data(1, 0, 0, "", "", 0, true)));
+    cache.emplace(builder.build<MockDeserializer>(make_mock_data(2, 0, 0, "", "", 0, true)));
+
+    std::size_t capacity = 0;
+    for (const auto& entry : cache) {
+        capacity += entry.data.capacity();
+    }
+    EXPECT_NE(cache.memory_usage().payload, 0U);
+    EXPECT_EQ(cache.memory_usage().payload, capacity);
+
+    // Heap-allocated string keys are counted on top of the buffer
+    using EmailEntry = EntryWithKeys_t<std::string>;
+    const EmailEntry entry(std::make_tuple(std::string(64, 'x')), make_mock_data(1, 0, 0, "", ""));
+    EXPECT_EQ(heap_bytes(entry),
+              entry.data.capacity() + multi_index_lru::heap_bytes(std::get<0>(entry.keys)));
+}
+
+// =============================================================================
+// Test: Partial updates
+// =============================================================================
+
+TEST(ZerializeCacheTest, PatchEntry) {
+    using namespace multi_index_lru;
+
+    struct IdTag {};
+    struct EmailTag {};
+    using Entry = EntryWithKeys_t<int64_t, std::string>;
+    using Cache = Container<
+        Entry,
+        boost::multi_index::indexed_by<
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<IdTag>,
+                key<0, Entry>
+            >,
+            boost::multi_index::hashed_unique<
+                boost::multi_index::tag<EmailTag>,
+                key<1, Entry>
+            >
+        >
+    >;
+
+    auto builder = make_entry_builder<Entry>(int64_field("id"), string_field("email"));
+    EXPECT_TRUE(builder.reads_field("id"));
+    EXPECT_TRUE(builder.reads_field("email"));
+    EXPECT_FALSE(builder.reads_field("score"));
+
+    Cache cache(10);
+    cache.emplace(builder.build<MockDeserializer>(make_mock_data(1, 0, 0, "a@x.com", "A", 1.0, true)));
+    cache.emplace(builder.build<MockDeserializer>(make_mock_data(2, 0, 0, "b@x.com", "B", 2.0, true)));
+    const auto* stored = cache.find_no_update<IdTag>(1LL)->data.data();
+
+    // Non-key field overwritten in place
+    auto set_score = [](std::vector<uint8_t>& bytes) {
+        const double score = 9.5;
+        std::memcpy(bytes.data() + offsetof(MockData, score), &score, sizeof(score));
+    };
+    EXPECT_EQ((patch_entry<IdTag, MockDeserializer>(cache, 1LL, builder, {"score"}, set_score)),
+              PatchResult::patched);
+    EXPECT_EQ((patch_entry<IdTag, MockDeserializer>(cache, 99LL, builder, {"score"}, set_score)),
+              PatchResult::not_found);
+    auto it = cache.find_no_update<IdTag>(1LL);
+    ASSERT_NE(it, cache.end<IdTag>());
+    EXPECT_EQ(it->data.data(), stored);
+    EXPECT_DOUBLE_EQ(it->deserialize<MockDeserializer>()["score"].asDouble(), 9.5);
+
+    // Key field changed: entry is re-indexed
+    auto set_id = [](int64_t id) {
+        return [id](std::vector<uint8_t>& bytes) {
+            std::memcpy(bytes.data() + offsetof(MockData, id), &id, sizeof(id));
+        };
+    };
+    EXPECT_EQ((patch_entry<IdTag, MockDeserializer>(cache, 1LL, builder, {"id"}, set_id(3))),
+              PatchResult::rekeyed);
+    EXPECT_FALSE(cache.contains_no_update<IdTag>(1LL));
+    EXPECT_TRUE(cache.contains_no_update<IdTag>(3LL));
+    EXPECT_TRUE(cache.contains_no_update<EmailTag>(std::string("a@x.com")));
+
+    // Collision on a unique index removes the patched entry
+    EXPECT_EQ((patch_entry<IdTag, MockDeserializer>(cache, 3LL, builder, {"id"}, set_id(2))),
+              PatchResult::erased);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_TRUE(cache.contains_no_update<EmailTag>(std::string("b@x.com")));
+}
+
 }  // namespace
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+# Copyright 2026 multi_index_lru contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Generate multi_index_lru cache types for one message of an SBE schema.
+
+Reads the schema XML, computes the byte offset of every key field (message
+header included) and writes a header with the entry type, index tags, index
+specifiers for Container and ExpirableContainer, and a FixedSbeEntryBuilder
+with compile-time offsets.
+
+Keys are given as NAME[:INDEX] where INDEX is one of hashed_unique,
+hashed_non_unique, ordered_unique, ordered_non_unique. The first key defaults
+to hashed_unique, the others to hashed_non_unique.
+
+Example:
+    sbe_cache_gen.py --schema market_cache.xml --message quote \\
+        --keys security_id template_id:ordered_non_unique \\
+        --namespace market_cache_gen --output quote_cache.hpp
+"""
+
+import argparse
+import sys
+import xml.etree.ElementTree as ET
+
+PRIMITIVES = {
+    "char": ("char", 1),
+    "int8": ("std::int8_t", 1),
+    "uint8": ("std::uint8_t", 1),
+    "int16": ("std::int16_t", 2),
+    "uint16": ("std::uint16_t", 2),
+    "int32": ("std::int32_t", 4),
+    "uint32": ("std::uint32_t", 4),
+    "int64": ("std::int64_t", 8),
+    "uint64": ("std::uint64_t", 8),
+    "float": (None, 4),
+    "double": (None, 8),
+}
+
+INDEX_KINDS = ("hashed_unique", "hashed_non_unique", "ordered_unique", "ordered_non_unique")
+
+
+class SchemaError(Exception):
+    pass
+
+
+def local_name(tag):
+    return tag.rsplit("}", 1)[-1]
+
+
+def children(element, name):
+    return [child for child in element if local_name(child.tag) == name]
+
+
+def load_types(root):
+    """Map type name -> XML element for every type, composite and enum."""
+    types = {}
+    for types_element in children(root, "types"):
+        for element in types_element:
+            types[element.get("name")] = element
+    return types
+
+
+def resolve_primitive(type_name, types):
+    """Return (cpp_type, size) for a primitive, simple type or enum."""
+    if type_name in PRIMITIVES:
+        return PRIMITIVES[type_name]
+    element = types.get(type_name)
+    if element is None:
+        raise SchemaError(f"unknown type '{type_name}'")
+    kind = local_name(element.tag)
+    if kind == "type":
+        if int(element.get("length", "1")) != 1:
+            raise SchemaError(f"type '{type_name}' is an array")
+        return PRIMITIVES[element.get("primitiveType")]
+    if kind == "enum":
+        return resolve_primitive(element.get("encodingType"), types)
+    if kind == "composite":
+        return (None, composite_size(element, types))
+    raise SchemaError(f"unsupported type '{type_name}'")
+
+
+def composite_size(element, types):
+    size = 0
+    for member in element:
+        offset = member.get("offset")
+        if offset is not None:
+            size = int(offset)
+        kind = local_name(member.tag)
+        if kind == "type":
+            length = int(member.get("length", "1"))
+            size += PRIMITIVES[member.get("primitiveType")][1] * length
+        elif kind == "composite":
+            size += composite_size(member, types)
+        elif kind == "ref":
+            size += resolve_primitive(member.get("type"), types)[1]
+        else:
+            size += resolve_primitive(member.get("encodingType"), types)[1]
+    return size
+
+
+def field_offsets(message, types, header_size):
+    """Map field name -> (cpp_type, offset) for the message's root block."""
+    fields = {}
+    offset = header_size
+    for field in children(message, "field"):
+        if field.get("offset") is not None:
+            offset = header_size + int(field.get("offset"))
+        cpp_type, size = resolve_primitive(field.get("type"), types)
+        if field.get("presence") == "constant" or (
+                field.get("type") in types and types[field.get("type")].get("presence") == "constant"):
+            size = 0  # constants are not encoded
+            cpp_type = None
+        fields[field.get("name")] = (cpp_type, offset)
+        offset += size
+    return fields
+
+
+def parse_key(spec, position):
+    name, _, kind = spec.partition(":")
+    if not kind:
+        kind = "hashed_unique" if position == 0 else "hashed_non_unique"
+    if kind not in INDEX_KINDS:
+        raise SchemaError(f"unknown index kind '{kind}' for key '{name}'")
+    return name, kind
+
+
+def generate(schema_path, message_name, key_specs, namespace, header_type):
+    root = ET.parse(schema_path).getroot()
+    if root.get("byteOrder", "littleEndian") != "littleEndian":
+        raise SchemaError("only littleEndian schemas are supported")
+    types = load_types(root)
+    if header_type not in types:
+        raise SchemaError(f"header type '{header_type}' not found")
+    header_size = composite_size(types[header_type], types)
+
+    messages = {m.get("name"): m for m in children(root, "message")}
+    if message_name not in messages:
+        raise SchemaError(f"message '{message_name}' not found")
+    message = messages[message_name]
+    fields = field_offsets(message, types, header_size)
+
+    keys = []
+    for position, spec in enumerate(key_specs):
+        name, kind = parse_key(spec, position)
+        if name not in fields:
+            raise SchemaError(f"key '{name}' is not a root block field of '{message_name}'")
+        cpp_type, offset = fields[name]
+        if cpp_type is None:
+            raise SchemaError(f"key '{name}' must be an encoded integer field")
+        keys.append((name, kind, cpp_type, offset))
+
+    key_types = ", ".join(cpp_type for _, _, cpp_type, _ in keys)
+    out = []
+    emit = out.append
+    emit("// Generated by tools/sbe_cache_gen.py from " + schema_path.replace("\\", "/").rsplit("/", 1)[-1]
+         + " (message '" + message_name + "'). Do not edit.")
+    emit("")
+    emit("#pragma once")
+    emit("")
+    emit("#include <multi_index_lru/container.hpp>")
+    emit("#include <multi_index_lru/expirable_container.hpp>")
+    emit("#include <multi_index_lru/sbe_fixed.hpp>")
+    emit("")
+    emit("#include <boost/multi_index/hashed_index.hpp>")
+    emit("#include <boost/multi_index/ordered_index.hpp>")
+    emit("")
+    emit("#include <cstddef>")
+    emit("#include <cstdint>")
+    emit("")
+    emit(f"namespace {namespace} {{")
+    emit("")
+    emit(f"/// Cache types for SBE message '{message_name}' (id {message.get('id')})")
+    emit(f"struct {message_name}_cache {{")
+    emit(f"    static constexpr std::uint16_t message_template_id = {message.get('id')};")
+    emit(f"    static constexpr std::size_t header_size = {header_size};")
+    emit("")
+    emit(f"    using entry_type = multi_index_lru::SbeEntryWithKeys_t<{key_types}>;")
+    emit("")
+    for name, _, cpp_type, offset in keys:
+        emit(f"    struct {name}_tag {{}};")
+    emit("")
+    for name, _, cpp_type, offset in keys:
+        emit(f"    using {name}_field = multi_index_lru::sbe_fixed_field<{cpp_type}, {offset}>;")
+    emit("")
+    field_list = ", ".join(f"{name}_field" for name, _, _, _ in keys)
+    emit(f"    using builder_type = multi_index_lru::FixedSbeEntryBuilder<entry_type, {field_list}>;")
+    emit("")
+    for extractor, alias in (("sbe_key", "indices"), ("sbe_timestamped_key", "expirable_indices")):
+        emit(f"    using {alias} = boost::multi_index::indexed_by<")
+        for position, (name, kind, _, _) in enumerate(keys):
+            separator = ">;" if position == len(keys) - 1 else ","
+            emit(f"        boost::multi_index::{kind}<")
+            emit(f"            boost::multi_index::tag<{name}_tag>,")
+            emit(f"            multi_index_lru::{extractor}<{position}, entry_type>>{separator}")
+        emit("")
+    emit("    using cache_type = multi_index_lru::Container<entry_type, indices>;")
+    emit("    using expirable_cache_type = multi_index_lru::ExpirableContainer<entry_type, expirable_indices>;")
+    emit("};")
+    emit("")
+    emit(f"}}  // namespace {namespace}")
+    return "\n".join(out) + "\n"
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--schema", required=True, help="SBE schema XML")
+    parser.add_argument("--message", required=True, help="message name")
+    parser.add_argument("--keys", required=True, nargs="+", help="key fields as NAME[:INDEX]")
+    parser.add_argument("--namespace", required=True, help="C++ namespace for generated types")
+    parser.add_argument("--output", required=True, help="header to write")
+    parser.add_argument("--header-type", default="messageHeader", help="message header composite")
+    args = parser.parse_args(argv)
+
+    try:
+        text = generate(args.schema, args.message, args.keys, args.namespace, args.header_type)
+    except (SchemaError, ET.ParseError) as error:
+        print(f"sbe_cache_gen: {error}", file=sys.stderr)
+        return 1
+    with open(args.output, "w", encoding="utf-8") as output:
+        output.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))